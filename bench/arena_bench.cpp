@@ -0,0 +1,134 @@
+// arena_bench.cpp
+// Allocation-heavy container workloads on the default allocator versus the
+// arenas in memory_manage/arena.hpp. Link with graph_code/graph.cpp.
+#include <cstdlib>
+#include <string>
+#include "bench_timer.hpp"
+#include "../memory_manage/arena.hpp"
+#include "../linkedlist_code/linked_list.hpp"
+#include "../queue_code/Queue.hpp"
+#include "../map_code/Map.hpp"
+#include "../graph_code/Graph.hpp"
+
+namespace {
+
+template <typename T>
+using PmrAlloc = std::pmr::polymorphic_allocator<T>;
+
+// Build a list, churn its front, then tear it down
+template <typename List>
+void list_workload(List& list, int n) {
+    for (int i = 0; i < n; ++i) {
+        list.push_back(i);
+    }
+    long sum = 0;
+    for (int i = 0; i < n / 2; ++i) {
+        sum += *list.pop_front();
+        list.push_back(i);
+    }
+    bench::do_not_optimize(sum);
+}
+
+template <typename Q>
+void queue_workload(Q& queue, int n) {
+    for (int i = 0; i < n; ++i) {
+        queue.enqueue(i);
+    }
+    bench::do_not_optimize(queue.size());
+}
+
+template <typename M>
+void map_workload(M& map, int n) {
+    for (int i = 0; i < n; ++i) {
+        map.put(i, i * 2);
+    }
+    bench::do_not_optimize(map.size());
+}
+
+void graph_workload(Graph& graph, int n) {
+    for (int i = 0; i < n; ++i) {
+        graph.addPath("place-" + std::to_string(i), "place-" + std::to_string((i * 7) % n));
+    }
+    bench::do_not_optimize(graph.countPaths("place-1"));
+}
+
+// Runs one workload on std::allocator and on each arena. The arenas are
+// created once and reset between repetitions, the way a hot path reuses them.
+// BlockPool forwards anything larger than its block upstream, so pool_block
+// must cover the container's largest request.
+template <typename DefaultRun, typename PmrRun>
+void compare(const std::string& name, size_t ops, DefaultRun default_run, PmrRun pmr_run,
+             size_t pool_block = 64, size_t pool_chunk = 4096) {
+    bench::report(name + " / new+delete", bench::measure(ops, default_run));
+
+    MonotonicArena monotonic(1 << 16);
+    bench::report(name + " / MonotonicArena", bench::measure(ops, [&] {
+        pmr_run(&monotonic);
+        monotonic.release();
+    }));
+
+    StackArena stack(512 << 20);
+    bench::report(name + " / StackArena", bench::measure(ops, [&] {
+        StackArena::Scope scope(stack);
+        pmr_run(&stack);
+    }));
+
+    BlockPool pool(pool_block, pool_chunk);
+    bench::report(name + " / BlockPool(" + std::to_string(pool_block) + ")", bench::measure(ops, [&] {
+        pmr_run(&pool);
+        pool.release();
+    }));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1'000'000;
+
+    compare("LinkedList<int>", n + n / 2,
+        [&] {
+            LinkedList<int> list;
+            list_workload(list, n);
+        },
+        [&](std::pmr::memory_resource* resource) {
+            LinkedList<int, PmrAlloc<int>> list(resource);
+            list_workload(list, n);
+        },
+        // LinkedList allocates whole node slabs, not single nodes
+        LinkedList<int, PmrAlloc<int>>::node_slab_bytes, 16);
+
+    compare("Queue<int>", n,
+        [&] {
+            Queue<int> queue;
+            queue_workload(queue, n);
+        },
+        [&](std::pmr::memory_resource* resource) {
+            Queue<int, PmrAlloc<int>> queue(resource);
+            queue_workload(queue, n);
+        });
+
+    // Map::put scans linearly, so keep this one small
+    int map_n = std::min(n, 4000);
+    compare("Map<int, int>", map_n,
+        [&] {
+            Map<int, int> map;
+            map_workload(map, map_n);
+        },
+        [&](std::pmr::memory_resource* resource) {
+            Map<int, int, PmrAlloc<std::pair<int, int>>> map(resource);
+            map_workload(map, map_n);
+        });
+
+    int graph_n = n / 10;
+    compare("Graph", graph_n,
+        [&] {
+            Graph graph;
+            graph_workload(graph, graph_n);
+        },
+        [&](std::pmr::memory_resource* resource) {
+            Graph graph(resource);
+            graph_workload(graph, graph_n);
+        });
+
+    return 0;
+}
@@ -0,0 +1,196 @@
+// async_poller_bench.cpp
+// How many sensors one thread can keep to a polling schedule. Each sensor
+// answers a read after an injected latency and is polled at a fixed rate,
+// every reading going into one DataLogger. Compared:
+//   - async/timer: AsyncPoller coroutines, reads waiting on the timer heap
+//   - async/pipe:  the same, reads waiting on a pipe through epoll
+//   - threads:     one thread per sensor, blocking sleeps, logger behind a mutex
+// For each row: achieved readings/s against the schedule's target, polls
+// skipped because the sensor fell behind, how late polls started, and the
+// CPU time the process used per second of wall time.
+//
+// usage: async_poller_bench [rate Hz, default 10] [latency ms, default 5] [seconds, default 2]
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+#include "../memory_manage/async_sensor.hpp"
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct Result {
+    std::uint64_t readings = 0;
+    PollStats stats;
+    double wallSeconds = 0;
+    double cpuSeconds = 0;
+    size_t sensors = 0;  // may fall short for threads
+};
+
+double cpu_seconds() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    auto seconds = [](const timeval& t) { return t.tv_sec + t.tv_usec * 1e-6; };
+    return seconds(usage.ru_utime) + seconds(usage.ru_stime);
+}
+
+Result run_async(size_t sensors, SensorBacking backing, std::chrono::nanoseconds interval, LatencyModel latency,
+                 double seconds) {
+    EventLoop loop;
+    DataLogger logger;
+    AsyncPoller poller(loop, logger, interval);
+    std::vector<std::unique_ptr<AsyncTemperatureSensor>> devices;
+    devices.reserve(sensors);
+    for (size_t i = 0; i < sensors; ++i) {
+        devices.push_back(std::make_unique<AsyncTemperatureSensor>(loop, static_cast<int>(i), latency, backing));
+        poller.add(*devices.back(), static_cast<double>(i) / sensors);
+    }
+
+    struct Window {
+        AsyncPoller& poller;
+        Result result;
+        clock_type::time_point start;
+        double cpuStart;
+    } window{poller, {}, clock_type::now(), cpu_seconds()};
+    window.result.sensors = sensors;
+
+    loop.call_at(window.start + std::chrono::duration_cast<clock_type::duration>(std::chrono::duration<double>(seconds)),
+                 [](void* context) {
+                     auto& w = *static_cast<Window*>(context);
+                     w.result.wallSeconds = std::chrono::duration<double>(clock_type::now() - w.start).count();
+                     w.result.cpuSeconds = cpu_seconds() - w.cpuStart;
+                     w.result.stats = w.poller.stats();
+                     w.result.readings = w.result.stats.readings;
+                     w.poller.stop();
+                 },
+                 &window);
+    loop.run();
+    return window.result;
+}
+
+// One thread per sensor: sleep to the next slot, block for the latency,
+// then log under the shared lock
+Result run_threads(size_t sensors, std::chrono::nanoseconds interval, LatencyModel latency, double seconds) {
+    DataLogger logger;
+    std::mutex lock;
+    std::atomic<bool> stopping{false};
+    PollStats total;
+    std::vector<std::thread> pool;
+    pool.reserve(sensors);
+
+    auto start = clock_type::now();
+    auto end = start + std::chrono::duration_cast<clock_type::duration>(std::chrono::duration<double>(seconds));
+    double cpuStart = cpu_seconds();
+    for (size_t i = 0; i < sensors; ++i) {
+        try {
+            pool.emplace_back([&, i] {
+                TemperatureSensor sensor(static_cast<int>(i));
+                PollStats mine;
+                auto next = start + std::chrono::duration_cast<clock_type::duration>(interval * (double(i) / sensors));
+                for (std::uint64_t k = 0; !stopping.load(std::memory_order_relaxed); ++k) {
+                    std::this_thread::sleep_until(next);
+                    auto started = clock_type::now();
+                    std::int64_t late = std::chrono::duration_cast<std::chrono::nanoseconds>(started - next).count();
+                    mine.totalLatenessNs += late;
+                    mine.maxLatenessNs = std::max(mine.maxLatenessNs, late);
+                    // Same latency stream as the async sensors
+                    std::this_thread::sleep_for(latency.delay(static_cast<int>(i), k));
+                    float value = sensor.readTemperature();
+                    auto now = clock_type::now();
+                    if (now >= end) {
+                        break;  // outside the measured window
+                    }
+                    {
+                        std::lock_guard<std::mutex> guard(lock);
+                        logger.logReading(static_cast<int>(i), value,
+                                          std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count());
+                    }
+                    ++mine.readings;
+                    next += interval;
+                    if (now > next) {
+                        auto behind = (now - next) / interval + 1;
+                        mine.missed += static_cast<std::uint64_t>(behind);
+                        next += behind * interval;
+                    }
+                }
+                std::lock_guard<std::mutex> guard(lock);
+                total.readings += mine.readings;
+                total.missed += mine.missed;
+                total.totalLatenessNs += mine.totalLatenessNs;
+                total.maxLatenessNs = std::max(total.maxLatenessNs, mine.maxLatenessNs);
+            });
+        } catch (const std::system_error&) {
+            break;  // out of threads: report what started
+        }
+    }
+
+    std::this_thread::sleep_until(end);
+    Result result;
+    result.wallSeconds = std::chrono::duration<double>(clock_type::now() - start).count();
+    result.cpuSeconds = cpu_seconds() - cpuStart;
+    stopping = true;
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    result.stats = total;
+    result.readings = total.readings;
+    result.sensors = pool.size();
+    return result;
+}
+
+void row(const std::string& mode, size_t requested, const Result& r, double rate) {
+    double target = static_cast<double>(r.sensors) * rate;
+    double achieved = r.readings / r.wallSeconds;
+    std::cout << std::left << std::setw(14) << mode << std::right << std::setw(8) << requested << std::setw(8)
+              << r.sensors << std::fixed << std::setprecision(0) << std::setw(12) << target << std::setw(12)
+              << achieved << std::setw(10) << r.stats.missed << std::setprecision(1) << std::setw(12)
+              << r.stats.meanLatenessNs() / 1e3 << std::setw(12) << r.stats.maxLatenessNs / 1e6 << std::setw(8)
+              << 100.0 * r.cpuSeconds / r.wallSeconds << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    double rate = argc > 1 ? std::strtod(argv[1], nullptr) : 10.0;
+    double latencyMs = argc > 2 ? std::strtod(argv[2], nullptr) : 5.0;
+    double seconds = argc > 3 ? std::strtod(argv[3], nullptr) : 2.0;
+    if (rate <= 0 || latencyMs < 0 || seconds <= 0) {
+        std::cerr << "usage: async_poller_bench [rate Hz] [latency ms] [seconds]\n";
+        return 1;
+    }
+    auto interval = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(1.0 / rate));
+    // Half the latency is fixed, half is jitter
+    auto half = std::chrono::microseconds(static_cast<std::int64_t>(latencyMs * 500));
+    LatencyModel latency{half, half};
+
+    // Each pipe-backed sensor holds two descriptors
+    rlimit files{};
+    getrlimit(RLIMIT_NOFILE, &files);
+    size_t maxPipes = files.rlim_cur == RLIM_INFINITY ? SIZE_MAX : (files.rlim_cur - 64) / 2;
+    const size_t maxThreads = 10'000;
+
+    std::cout << rate << " Hz per sensor, " << latencyMs << " ms read latency, " << seconds << " s per row\n";
+    std::cout << std::left << std::setw(14) << "mode" << std::right << std::setw(8) << "sensors" << std::setw(8)
+              << "ran" << std::setw(12) << "target/s" << std::setw(12) << "achieved/s" << std::setw(10) << "missed"
+              << std::setw(12) << "late us" << std::setw(12) << "max late ms" << std::setw(8) << "cpu %" << "\n";
+    for (size_t sensors : {100, 1'000, 5'000, 10'000, 20'000}) {
+        row("async/timer", sensors, run_async(sensors, SensorBacking::timer, interval, latency, seconds), rate);
+        if (sensors <= maxPipes) {
+            row("async/pipe", sensors, run_async(sensors, SensorBacking::pipe, interval, latency, seconds), rate);
+        }
+        if (sensors <= maxThreads) {
+            row("threads", sensors, run_threads(sensors, interval, latency, seconds), rate);
+        }
+    }
+    return 0;
+}
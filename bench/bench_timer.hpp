@@ -0,0 +1,44 @@
+// bench_timer.hpp
+#ifndef BENCH_TIMER_HPP
+#define BENCH_TIMER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace bench {
+
+// Keep the optimizer from discarding a value we computed only for timing
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Run body `reps` times and return the best time per operation in nanoseconds
+template <typename Body>
+double measure(size_t ops, Body&& body, int reps = 5) {
+    double best = 0.0;
+    for (int r = 0; r < reps; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto stop = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+        if (r == 0 || ns < best) {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+inline void report(const std::string& name, double ns_per_op) {
+    std::cout << std::left << std::setw(48) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(2)
+              << ns_per_op << " ns/op  "
+              << std::setw(10) << std::setprecision(1) << 1e3 / ns_per_op << " Mops/s\n";
+}
+
+} // namespace bench
+
+#endif // BENCH_TIMER_HPP
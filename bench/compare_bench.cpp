@@ -0,0 +1,223 @@
+// compare_bench.cpp
+// Compares two JSON result files written by bench_suite --json and flags
+// regressions. A benchmark regresses when its median slows down by more
+// than the threshold and even its fastest repetition is slower than the
+// baseline p90, i.e. the two runs barely overlap; noise in a few
+// repetitions is not flagged.
+//
+// usage: bench_compare BASELINE.json CURRENT.json [threshold percent, default 10]
+// Exit status: 0 no regressions, 1 regressions found, 2 bad input.
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Entry {
+    double median_ns = 0;
+    double min_ns = 0;
+    double p90_ns = 0;
+};
+
+// Just enough JSON for the harness output: objects, arrays, strings and
+// numbers. Each object with a "name" inside "results" becomes an Entry.
+class ResultReader {
+public:
+    explicit ResultReader(std::string text) : text(std::move(text)) {}
+
+    std::map<std::string, Entry> read() {
+        skip_space();
+        value("");
+        return entries;
+    }
+
+private:
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::runtime_error(what + " at offset " + std::to_string(pos));
+    }
+
+    // Every read of the input goes through peek() or get(), so truncated
+    // files fail cleanly instead of running off the end
+    char peek() const {
+        if (pos >= text.size()) {
+            fail("unexpected end of input");
+        }
+        return text[pos];
+    }
+
+    char get() {
+        char c = peek();
+        ++pos;
+        return c;
+    }
+
+    void skip_space() {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+            ++pos;
+        }
+    }
+
+    void expect(char c) {
+        skip_space();
+        if (peek() != c) {
+            fail(std::string("expected '") + c + "'");
+        }
+        ++pos;
+    }
+
+    std::string string_literal() {
+        expect('"');
+        std::string out;
+        while (peek() != '"') {
+            char c = get();
+            out += c == '\\' ? get() : c;
+        }
+        expect('"');
+        return out;
+    }
+
+    double number() {
+        skip_space();
+        peek();
+        size_t used = 0;
+        double v = std::stod(text.substr(pos, 32), &used);
+        pos += used;
+        return v;
+    }
+
+    // Parses one value; `key` is the member name it was found under
+    void value(const std::string& key) {
+        skip_space();
+        char c = peek();
+        if (c == '{') {
+            object(key);
+        } else if (c == '[') {
+            ++pos;
+            skip_space();
+            if (peek() == ']') {
+                ++pos;
+                return;
+            }
+            char next;
+            do {
+                value(key);
+                skip_space();
+            } while ((next = get()) == ',');
+            if (next != ']') {
+                fail("expected ']'");
+            }
+        } else if (c == '"') {
+            string_literal();
+        } else {
+            number();
+        }
+    }
+
+    void object(const std::string& parent) {
+        expect('{');
+        std::string name;
+        Entry entry;
+        skip_space();
+        if (peek() == '}') {
+            ++pos;
+            return;
+        }
+        char next;
+        do {
+            std::string key = string_literal();
+            expect(':');
+            skip_space();
+            if (parent == "results" && key == "name") {
+                name = string_literal();
+            } else if (parent == "results" && peek() != '{' && peek() != '[' && peek() != '"') {
+                double v = number();
+                if (key == "median_ns") {
+                    entry.median_ns = v;
+                } else if (key == "min_ns") {
+                    entry.min_ns = v;
+                } else if (key == "p90_ns") {
+                    entry.p90_ns = v;
+                }
+            } else {
+                value(key);
+            }
+            skip_space();
+        } while ((next = get()) == ',');
+        if (next != '}') {
+            fail("expected '}'");
+        }
+        if (!name.empty()) {
+            entries[name] = entry;
+        }
+    }
+
+    std::string text;
+    size_t pos = 0;
+    std::map<std::string, Entry> entries;
+};
+
+std::map<std::string, Entry> load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return ResultReader(buffer.str()).read();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " BASELINE.json CURRENT.json [threshold percent]\n";
+        return 2;
+    }
+    double threshold = argc > 3 ? std::atof(argv[3]) / 100.0 : 0.10;
+
+    std::map<std::string, Entry> baseline, current;
+    try {
+        baseline = load(argv[1]);
+        current = load(argv[2]);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+
+    int regressions = 0;
+    std::cout << std::left << std::setw(40) << "benchmark" << std::right << std::setw(14) << "baseline ns"
+              << std::setw(14) << "current ns" << std::setw(10) << "change" << "\n";
+    for (const auto& [name, now] : current) {
+        auto it = baseline.find(name);
+        std::cout << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(2);
+        if (it == baseline.end()) {
+            std::cout << std::setw(14) << "-" << std::setw(14) << now.median_ns << std::setw(10) << "new" << "\n";
+            continue;
+        }
+        const Entry& before = it->second;
+        double change = before.median_ns > 0 ? now.median_ns / before.median_ns - 1.0 : 0.0;
+        std::cout << std::setw(14) << before.median_ns << std::setw(14) << now.median_ns
+                  << std::setw(9) << std::showpos << 100 * change << std::noshowpos << "%";
+        if (change > threshold && now.min_ns > before.p90_ns) {
+            std::cout << "  REGRESSION";
+            ++regressions;
+        } else if (change < -threshold && now.p90_ns < before.min_ns) {
+            std::cout << "  improved";
+        }
+        std::cout << "\n";
+    }
+    for (const auto& [name, before] : baseline) {
+        if (!current.count(name)) {
+            std::cout << std::left << std::setw(40) << name << std::right << "  missing from current run\n";
+        }
+    }
+    std::cout << regressions << " regression(s) above " << std::setprecision(1) << 100 * threshold << "%\n";
+    return regressions ? 1 : 0;
+}
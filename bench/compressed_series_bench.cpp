@@ -0,0 +1,113 @@
+// compressed_series_bench.cpp
+// Size and speed of Gorilla-compressed series on sensor-like data:
+// 1 s sampling with occasional jitter and dropouts, and a slow daily swing
+// plus noise, quantized to 1/16 °C like a 12-bit digital thermometer.
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "bench_timer.hpp"
+#include "../memory_manage/compressed_series.hpp"
+
+namespace {
+
+struct Trace {
+    std::vector<std::int64_t> timestamps;
+    std::vector<float> values;
+};
+
+Trace make_trace(int sensor, int readings) {
+    std::mt19937 rng(sensor);
+    std::normal_distribution<double> noise(0.0, 0.05);
+    std::uniform_int_distribution<int> jitter(0, 99);
+    Trace trace;
+    trace.timestamps.reserve(readings);
+    trace.values.reserve(readings);
+    std::int64_t t = 1'700'000'000'000;  // ms
+    double base = 20.0 + sensor * 1.5;
+    for (int i = 0; i < readings; ++i) {
+        int roll = jitter(rng);
+        t += roll == 0 ? 5000 : roll < 5 ? 1000 + roll : 1000;  // dropout, jitter, on time
+        double swing = 3.0 * std::sin(2 * M_PI * (t % 86'400'000) / 86'400'000.0);
+        double raw = base + swing + noise(rng);
+        trace.timestamps.push_back(t);
+        trace.values.push_back(static_cast<float>(std::round(raw * 16.0) / 16.0));
+    }
+    return trace;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int sensors = argc > 1 ? std::atoi(argv[1]) : 100;
+    int readings = argc > 2 ? std::atoi(argv[2]) : 100'000;
+    size_t total = static_cast<size_t>(sensors) * readings;
+
+    std::vector<Trace> traces;
+    for (int s = 0; s < sensors; ++s) {
+        traces.push_back(make_trace(s, readings));
+    }
+
+    std::vector<CompressedSeries> series(sensors);
+    double encode_ns = bench::measure(total, [&] {
+        series.assign(sensors, CompressedSeries());
+        for (int s = 0; s < sensors; ++s) {
+            for (int i = 0; i < readings; ++i) {
+                series[s].append(traces[s].timestamps[i], traces[s].values[i]);
+            }
+        }
+    }, 3);
+
+    size_t bytes = 0;
+    for (const auto& one : series) {
+        bytes += one.bytes_used();
+    }
+    std::cout << sensors << " sensors x " << readings << " readings: "
+              << static_cast<double>(bytes) / total << " bytes/reading compressed (raw timestamp+float: "
+              << sizeof(std::int64_t) + sizeof(float) << ", float only: " << sizeof(float) << ")\n";
+
+    bench::report("encode (append)", encode_ns);
+
+    std::vector<std::int64_t> timestamps(readings);
+    std::vector<float> values(readings);
+    bench::report("decode (Block::decode)", bench::measure(total, [&] {
+        for (const auto& one : series) {
+            size_t offset = 0;
+            for (const auto& block : one.blocks()) {
+                block.decode(timestamps.data() + offset, values.data() + offset);
+                offset += block.count;
+            }
+            bench::do_not_optimize(values[offset - 1]);
+        }
+    }));
+
+    bench::report("stats, raw floats (SIMD kernel)", bench::measure(total, [&] {
+        for (const auto& trace : traces) {
+            bench::do_not_optimize(series_kernels::stats(trace.values.data(), trace.values.size()));
+        }
+    }));
+    bench::report("stats, decode + SIMD kernel", bench::measure(total, [&] {
+        for (const auto& one : series) {
+            SeriesStats total_stats;
+            one.scan(0, INT64_MAX, [&](const std::int64_t*, const float* vs, size_t n) {
+                total_stats.merge(series_kernels::stats(vs, n));
+            });
+            bench::do_not_optimize(total_stats);
+        }
+    }));
+    bench::report("stats, block summaries only", bench::measure(total, [&] {
+        for (const auto& one : series) {
+            bench::do_not_optimize(one.stats());
+        }
+    }));
+
+    // Middle half of each series: summaries for inner blocks, decode for the two edges
+    bench::report("range stats (middle 50%)", bench::measure(total / 2, [&] {
+        for (int s = 0; s < sensors; ++s) {
+            std::int64_t from = traces[s].timestamps[readings / 4];
+            std::int64_t to = traces[s].timestamps[readings * 3 / 4];
+            bench::do_not_optimize(series[s].stats(from, to));
+        }
+    }));
+    return 0;
+}
@@ -0,0 +1,94 @@
+// concurrent_stack_bench.cpp
+// Contention benchmark: ConcurrentStack against a mutex-guarded Stack.
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "bench_timer.hpp"
+#include "../stack_code/stack_mod.hpp"
+#include "../stack_code/concurrent_stack.hpp"
+
+namespace {
+
+class LockedStack {
+public:
+    void push(int value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        stack.push(value);
+    }
+
+    std::optional<int> try_pop() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stack.try_pop();
+    }
+
+private:
+    std::mutex mutex;
+    Stack<int> stack{1000};
+};
+
+// Every thread alternates push and pop, the symmetric pattern that the
+// elimination array is meant to absorb.
+template <typename S>
+double run_pairs(int threads, int pairs_per_thread) {
+    S stack;
+    return bench::measure(static_cast<size_t>(threads) * pairs_per_thread * 2, [&] {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&stack, pairs_per_thread] {
+                long sum = 0;
+                for (int i = 0; i < pairs_per_thread; ++i) {
+                    stack.push(i);
+                    if (auto v = stack.try_pop()) {
+                        sum += *v;
+                    }
+                }
+                bench::do_not_optimize(sum);
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+    }, 3);
+}
+
+// Amortized transfers: each thread moves batches of 64 with one CAS each way
+double run_batches(int threads, int batches_per_thread) {
+    constexpr int batch = 64;
+    ConcurrentStack<int> stack;
+    return bench::measure(static_cast<size_t>(threads) * batches_per_thread * batch * 2, [&] {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&stack, batches_per_thread] {
+                std::vector<int> items(batch, 1);
+                long sum = 0;
+                for (int i = 0; i < batches_per_thread; ++i) {
+                    stack.push_chain(items.begin(), items.end());
+                    for (int v : stack.pop_all()) {
+                        sum += v;
+                    }
+                }
+                bench::do_not_optimize(sum);
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+    }, 3);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int pairs = argc > 1 ? std::atoi(argv[1]) : 1'000'000;
+
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << "\n";
+    for (int threads : {1, 2, 4, 8, 16}) {
+        std::string suffix = " x" + std::to_string(threads) + " threads";
+        bench::report("mutex + Stack<int> push/pop" + suffix, run_pairs<LockedStack>(threads, pairs / threads));
+        bench::report("ConcurrentStack<int> push/pop" + suffix,
+                      run_pairs<ConcurrentStack<int>>(threads, pairs / threads));
+        bench::report("ConcurrentStack<int> batch 64" + suffix, run_batches(threads, pairs / threads / 64));
+    }
+    return 0;
+}
@@ -0,0 +1,125 @@
+// const_map_bench.cpp
+// Lookups into a static string-keyed table of 10 to 10^4 entries: ConstMap
+// (perfect hash built at compile time) against Map's linear scan,
+// std::unordered_map<std::string, int> and binary search over a sorted
+// array of string_views. All lookups hit; the key order is shuffled.
+//
+// usage: const_map_bench [lookups per size, default 1M]
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "bench_timer.hpp"
+#include "../map_code/Map.hpp"
+#include "../map_code/const_map.hpp"
+
+namespace {
+
+constexpr size_t key_length = 14;
+
+// N keys of the form "sensor/xxxxxxx", generated at compile time so the
+// map over them can be too
+template <size_t N>
+struct KeyTable {
+    static constexpr std::array<char, N * key_length> chars = [] {
+        std::array<char, N * key_length> c{};
+        for (size_t i = 0; i < N; ++i) {
+            std::string_view prefix = "sensor/";
+            std::copy(prefix.begin(), prefix.end(), c.begin() + i * key_length);
+            size_t v = i * 7919 + 12345;
+            for (size_t d = prefix.size(); d < key_length; ++d) {
+                c[i * key_length + d] = static_cast<char>('a' + v % 26);
+                v /= 26;
+            }
+        }
+        return c;
+    }();
+
+    static constexpr std::array<std::pair<std::string_view, int>, N> entries = [] {
+        std::array<std::pair<std::string_view, int>, N> e{};
+        for (size_t i = 0; i < N; ++i) {
+            e[i] = {std::string_view(chars.data() + i * key_length, key_length), static_cast<int>(i)};
+        }
+        return e;
+    }();
+
+    static constexpr ConstMap<int, N> map{entries};
+};
+
+template <size_t N>
+void run(size_t lookups) {
+    const auto& entries = KeyTable<N>::entries;
+    const auto& const_map = KeyTable<N>::map;
+
+    std::vector<size_t> order(lookups);
+    std::mt19937 rng(N);
+    for (auto& i : order) {
+        i = rng() % N;
+    }
+    std::vector<std::string_view> views;
+    std::vector<std::string> strings;
+    for (size_t i : order) {
+        views.push_back(entries[i].first);
+        strings.emplace_back(entries[i].first);
+    }
+
+    Map<std::string, int> map;
+    std::unordered_map<std::string, int> hashed;
+    std::vector<std::pair<std::string_view, int>> sorted(entries.begin(), entries.end());
+    for (const auto& [key, value] : entries) {
+        map.put(std::string(key), value);
+        hashed.emplace(key, value);
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    std::string suffix = " (" + std::to_string(N) + " keys)";
+    bench::report("ConstMap::get" + suffix, bench::measure(lookups, [&] {
+        long sum = 0;
+        for (std::string_view key : views) {
+            sum += const_map.get(key);
+        }
+        bench::do_not_optimize(sum);
+    }));
+    bench::report("std::unordered_map::find" + suffix, bench::measure(lookups, [&] {
+        long sum = 0;
+        for (const std::string& key : strings) {
+            sum += hashed.find(key)->second;
+        }
+        bench::do_not_optimize(sum);
+    }));
+    bench::report("sorted array lower_bound" + suffix, bench::measure(lookups, [&] {
+        long sum = 0;
+        for (std::string_view key : views) {
+            auto it = std::lower_bound(sorted.begin(), sorted.end(), key,
+                                       [](const auto& entry, std::string_view k) { return entry.first < k; });
+            sum += it->second;
+        }
+        bench::do_not_optimize(sum);
+    }));
+    // The linear scan gets fewer lookups so large tables finish
+    size_t scans = std::min(lookups, size_t{20'000'000} / N);
+    bench::report("Map::get" + suffix, bench::measure(scans, [&] {
+        long sum = 0;
+        for (size_t i = 0; i < scans; ++i) {
+            sum += map.get(strings[i]);
+        }
+        bench::do_not_optimize(sum);
+    }, 3));
+    std::cout << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t lookups = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    run<10>(lookups);
+    run<100>(lookups);
+    run<1000>(lookups);
+    run<10000>(lookups);
+    return 0;
+}
@@ -0,0 +1,93 @@
+// container_stats_bench.cpp
+// Cost of the container stats layer. CMake builds this file twice:
+// container_stats_bench with CONTAINER_STATS off and
+// container_stats_bench_enabled with it on. Both time the same workloads;
+// the enabled build also prints each container's counters and the global
+// JSON snapshot, with every allocation routed through TrackingAllocator.
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "bench_timer.hpp"
+#include "../queue_code/Queue.hpp"
+#include "../map_code/Map.hpp"
+#include "../stack_code/stack_mod.hpp"
+#include "../linkedlist_code/linked_list.hpp"
+#include "../memory_manage/container_stats.hpp"
+
+using container_stats::TrackingAllocator;
+
+// Disabled stats must not change the containers' layout
+static_assert(container_stats::enabled || sizeof(Queue<int>) == sizeof(std::vector<int>));
+static_assert(container_stats::enabled || sizeof(SmallStack<int, 16>) == sizeof(int) * 16 + 2 * sizeof(size_t) + sizeof(int*));
+
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 2'000;
+    std::cout << "container stats " << (container_stats::enabled ? "ON" : "OFF") << ", n = " << n << "\n";
+
+    using IntQueue = Queue<int, TrackingAllocator<int>>;
+    using Entry = std::pair<int, int>;
+    using IntMap = Map<int, int, TrackingAllocator<Entry>>;
+    using IntList = LinkedList<int, TrackingAllocator<int>>;
+
+    IntQueue queue;
+    bench::report("Queue enqueue + dequeue", bench::measure(2 * n, [&] {
+        queue = IntQueue();
+        for (int i = 0; i < n; ++i) {
+            queue.enqueue(i);
+        }
+        while (!queue.isEmpty()) {
+            queue.dequeue();
+        }
+    }));
+
+    IntMap map;
+    bench::report("Map put + get", bench::measure(2 * n, [&] {
+        map = IntMap();
+        for (int i = 0; i < n; ++i) {
+            map.put(i * 7919 % n, i);
+        }
+        long sum = 0;
+        for (int i = 0; i < n; ++i) {
+            sum += map.get(i);
+        }
+        bench::do_not_optimize(sum);
+    }));
+
+    IntList list;
+    bench::report("LinkedList push_back + find + remove", bench::measure(3 * n, [&] {
+        list.clear();
+        for (int i = 0; i < n; ++i) {
+            list.push_back(i);
+        }
+        int found = 0;
+        for (int i = 0; i < n; i += 7) {
+            found += list.find(i) != list.end();
+        }
+        for (int i = n - 1; i >= 0; i -= 2) {
+            list.remove(i);
+        }
+        bench::do_not_optimize(found);
+    }));
+
+    SmallStack<int, 16> stack;
+    bench::report("SmallStack push + pop", bench::measure(2 * n, [&] {
+        stack = SmallStack<int, 16>();
+        for (int i = 0; i < n; ++i) {
+            stack.push(i);
+        }
+        long sum = 0;
+        while (!stack.empty()) {
+            sum += stack.pop();
+        }
+        bench::do_not_optimize(sum);
+    }));
+
+    if constexpr (container_stats::enabled) {
+        std::cout << "\nQueue: " << container_stats::to_json(queue.getStats())
+                  << "\n\nMap: " << container_stats::to_json(map.getStats())
+                  << "\n\nLinkedList: " << container_stats::to_json(list.stats())
+                  << "\n\nSmallStack: " << container_stats::to_json(stack.stats())
+                  << "\n\nglobal: " << container_stats::snapshot_json() << "\n";
+    }
+    return 0;
+}
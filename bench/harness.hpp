@@ -0,0 +1,238 @@
+// harness.hpp
+// Micro-benchmark harness for the suite: warmup runs, repeated timed runs,
+// percentiles over the repetitions and cycle timing from the time-stamp
+// counter (no performance-counter access needed). Results print as a table
+// and can be written as JSON for bench_compare.
+#ifndef BENCH_HARNESS_HPP
+#define BENCH_HARNESS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "bench_timer.hpp"
+
+namespace bench {
+
+// Reference cycles from the invariant TSC on x86, fenced so the read is not
+// reordered around the timed code; steady_clock nanoseconds elsewhere
+class CycleClock {
+public:
+    static std::uint64_t now() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_lfence();
+        std::uint64_t ticks = __rdtsc();
+        _mm_lfence();
+        return ticks;
+#else
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    // Measured once against steady_clock over ~50 ms
+    static double ns_per_tick() {
+        static const double value = calibrate();
+        return value;
+    }
+
+private:
+    static double calibrate() {
+        auto wall_start = std::chrono::steady_clock::now();
+        std::uint64_t start = now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        std::uint64_t stop = now();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - wall_start).count();
+        return stop > start ? ns / static_cast<double>(stop - start) : 1.0;
+    }
+};
+
+struct Options {
+    int warmup = 2;
+    int repetitions = 15;
+    std::string filter;     // run only benchmarks whose name contains this
+    std::string json_path;  // write results here when set
+};
+
+// --warmup N, --reps N, --filter TEXT, --json PATH
+inline Options parse_options(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument(arg + " needs a value");
+            }
+            return argv[++i];
+        };
+        if (arg == "--warmup") {
+            options.warmup = std::stoi(value());
+        } else if (arg == "--reps") {
+            options.repetitions = std::max(1, std::stoi(value()));
+        } else if (arg == "--filter") {
+            options.filter = value();
+        } else if (arg == "--json") {
+            options.json_path = value();
+        } else {
+            throw std::invalid_argument("unknown option " + arg +
+                                        " (expected --warmup, --reps, --filter or --json)");
+        }
+    }
+    return options;
+}
+
+// Per-operation times over all repetitions of one benchmark
+struct Result {
+    std::string name;
+    size_t ops = 0;  // operations per repetition
+    std::vector<double> samples_ns;  // ns/op of each repetition, sorted
+    double min_ns = 0, median_ns = 0, p90_ns = 0, p99_ns = 0, max_ns = 0;
+    double mean_ns = 0, stddev_ns = 0;
+    double cycles_per_op = 0;  // median, in reference cycles
+};
+
+// Nearest-rank percentile of sorted samples
+inline double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    auto rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+class Harness {
+public:
+    explicit Harness(Options options) : options(std::move(options)) {}
+
+    // Times body(), which performs `ops` operations
+    template <typename Body>
+    void run(const std::string& name, size_t ops, Body&& body) {
+        run(name, ops, [] {}, std::forward<Body>(body));
+    }
+
+    // setup() runs untimed before every repetition, e.g. to refill a container
+    template <typename Setup, typename Body>
+    void run(const std::string& name, size_t ops, Setup&& setup, Body&& body) {
+        if (!options.filter.empty() && name.find(options.filter) == std::string::npos) {
+            return;
+        }
+        for (int w = 0; w < options.warmup; ++w) {
+            setup();
+            body();
+        }
+        std::vector<double> ticks;
+        for (int r = 0; r < options.repetitions; ++r) {
+            setup();
+            std::uint64_t start = CycleClock::now();
+            body();
+            std::uint64_t stop = CycleClock::now();
+            ticks.push_back(static_cast<double>(stop - start) / static_cast<double>(ops));
+        }
+        std::sort(ticks.begin(), ticks.end());
+
+        Result result;
+        result.name = name;
+        result.ops = ops;
+        result.cycles_per_op = percentile(ticks, 0.5);
+        double scale = CycleClock::ns_per_tick();
+        for (double t : ticks) {
+            result.samples_ns.push_back(t * scale);
+        }
+        const auto& s = result.samples_ns;
+        result.min_ns = s.front();
+        result.max_ns = s.back();
+        result.median_ns = percentile(s, 0.5);
+        result.p90_ns = percentile(s, 0.9);
+        result.p99_ns = percentile(s, 0.99);
+        double sum = 0.0;
+        for (double v : s) {
+            sum += v;
+        }
+        result.mean_ns = sum / s.size();
+        double squares = 0.0;
+        for (double v : s) {
+            squares += (v - result.mean_ns) * (v - result.mean_ns);
+        }
+        result.stddev_ns = s.size() > 1 ? std::sqrt(squares / (s.size() - 1)) : 0.0;
+        print(result);
+        results.push_back(std::move(result));
+    }
+
+    [[nodiscard]] const std::vector<Result>& all() const noexcept { return results; }
+
+    void write_json(std::ostream& out) const {
+        out << "{\n  \"ns_per_tick\": " << std::setprecision(9) << CycleClock::ns_per_tick()
+            << ",\n  \"warmup\": " << options.warmup
+            << ",\n  \"repetitions\": " << options.repetitions
+            << ",\n  \"results\": [\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            out << "    {\"name\": \"" << escape(r.name) << "\", \"ops\": " << r.ops
+                << std::setprecision(6)
+                << ", \"min_ns\": " << r.min_ns << ", \"median_ns\": " << r.median_ns
+                << ", \"p90_ns\": " << r.p90_ns << ", \"p99_ns\": " << r.p99_ns
+                << ", \"max_ns\": " << r.max_ns << ", \"mean_ns\": " << r.mean_ns
+                << ", \"stddev_ns\": " << r.stddev_ns << ", \"cycles_per_op\": " << r.cycles_per_op
+                << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+
+    // Writes the JSON file if one was requested; returns main's exit code
+    int finish() const {
+        if (options.json_path.empty()) {
+            return 0;
+        }
+        std::ofstream file(options.json_path);
+        write_json(file);
+        if (!file) {
+            std::cerr << "could not write " << options.json_path << "\n";
+            return 1;
+        }
+        std::cout << "wrote " << results.size() << " results to " << options.json_path << "\n";
+        return 0;
+    }
+
+private:
+    static std::string escape(const std::string& text) {
+        std::string out;
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+            }
+            out += c;
+        }
+        return out;
+    }
+
+    void print(const Result& r) {
+        if (results.empty()) {
+            std::cout << std::left << std::setw(40) << "benchmark" << std::right
+                      << std::setw(12) << "median ns" << std::setw(12) << "p90 ns"
+                      << std::setw(12) << "p99 ns" << std::setw(12) << "min ns"
+                      << std::setw(12) << "cycles" << "\n";
+        }
+        std::cout << std::left << std::setw(40) << r.name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << r.median_ns << std::setw(12) << r.p90_ns
+                  << std::setw(12) << r.p99_ns << std::setw(12) << r.min_ns
+                  << std::setw(12) << std::setprecision(1) << r.cycles_per_op << "\n";
+    }
+
+    Options options;
+    std::vector<Result> results;
+};
+
+} // namespace bench
+
+#endif // BENCH_HARNESS_HPP
@@ -0,0 +1,79 @@
+// ingest_pipeline_bench.cpp
+// Load generator for IngestPipeline: drives simulated sensors through the
+// poll -> aggregate -> sink stages and prints per-stage depth and throughput.
+//
+//     ingest_pipeline_bench [sensors] [rounds_per_sec] [seconds] [batch] [pollers] [aggregators]
+//
+// rounds_per_sec = 0 polls as fast as the pipeline accepts readings.
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include "bench_timer.hpp"
+#include "../memory_manage/ingest_pipeline.hpp"
+
+namespace {
+
+void print_stages(const IngestPipeline& pipeline) {
+    for (const auto& stage : pipeline.stats()) {
+        std::cout << "  " << std::left << std::setw(10) << stage.name << std::right
+                  << std::setw(12) << stage.items << " items"
+                  << std::setw(12) << std::fixed << std::setprecision(0) << stage.items_per_second << " /s"
+                  << std::setw(8) << stage.queue_depth << " queued"
+                  << std::setw(8) << stage.stalls << " stalls\n";
+    }
+}
+
+// Runs an unthrottled pipeline for a fixed time and returns ns per reading
+double run_for(IngestConfig config, std::chrono::milliseconds duration) {
+    IngestPipeline pipeline(config);
+    pipeline.start();
+    std::this_thread::sleep_for(duration);
+    pipeline.stop();
+    auto poll = pipeline.stats()[0];
+    return 1e9 / poll.items_per_second;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    IngestConfig config;
+    config.sensors = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    config.poll_rate_hz = argc > 2 ? std::atof(argv[2]) : 10.0;
+    double seconds = argc > 3 ? std::atof(argv[3]) : 3.0;
+    config.batch_size = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 64;
+    config.pollers = argc > 5 ? std::atoi(argv[5]) : 2;
+    config.aggregators = argc > 6 ? std::atoi(argv[6]) : 2;
+
+    std::cout << config.sensors << " sensors, " << config.poll_rate_hz << " rounds/s, batch "
+              << config.batch_size << ", " << config.pollers << " pollers, "
+              << config.aggregators << " aggregators\n";
+
+    size_t published = 0;
+    IngestPipeline pipeline(config, [&published](const SensorSummary&) { ++published; });
+    pipeline.start();
+    auto end = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+    while (std::chrono::steady_clock::now() < end) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        print_stages(pipeline);
+        std::cout << "\n";
+    }
+    pipeline.stop();
+    std::cout << "after drain:\n";
+    print_stages(pipeline);
+    if (auto summary = pipeline.latest(0)) {
+        std::cout << "sensor 0 last window: " << summary->stats.count << " readings, mean "
+                  << std::setprecision(2) << summary->stats.mean() << "\n";
+    }
+    std::cout << published << " summaries published\n\n";
+
+    // Unthrottled end-to-end cost per reading as the hand-off batch grows
+    for (size_t batch : {1, 8, 64, 512}) {
+        IngestConfig sweep = config;
+        sweep.poll_rate_hz = 0.0;
+        sweep.batch_size = batch;
+        bench::report("IngestPipeline unthrottled, batch " + std::to_string(batch),
+                      run_for(sweep, std::chrono::milliseconds(1000)));
+    }
+    return 0;
+}
@@ -0,0 +1,19 @@
+// legacy_stack.cpp
+// stack_bench's fill/drain loop on the original stack.h.
+#include "legacy_stack.hpp"
+#include "bench_timer.hpp"
+#include "../stack_code/stack.h"
+
+void legacy_stack_fill_drain(int depth, int rounds) {
+    Stack<int> s(depth);
+    long sum = 0;
+    for (int r = 0; r < rounds; ++r) {
+        for (int i = 0; i < depth; ++i) {
+            s.push(i);
+        }
+        for (int i = 0; i < depth; ++i) {
+            sum += s.pop();
+        }
+    }
+    bench::do_not_optimize(sum);
+}
@@ -0,0 +1,9 @@
+#ifndef LEGACY_STACK_HPP
+#define LEGACY_STACK_HPP
+
+// The stack_bench workload on stack.h's Stack<int>. It lives in its own
+// translation unit because stack.h and stack_mod.hpp both define Stack and
+// StackException.
+void legacy_stack_fill_drain(int depth, int rounds);
+
+#endif // LEGACY_STACK_HPP
@@ -0,0 +1,78 @@
+// linked_list_pool_bench.cpp
+// Node churn and teardown of the pooled LinkedList against the standard
+// lists, which allocate and free every node individually.
+#include <chrono>
+#include <cstdlib>
+#include <forward_list>
+#include <list>
+#include <string>
+#include "bench_timer.hpp"
+#include "../linkedlist_code/linked_list.hpp"
+
+namespace {
+
+// Keep the list at a steady size while cycling nodes through it
+template <typename List>
+void churn(List& list, int live, int ops) {
+    for (int i = 0; i < live; ++i) {
+        list.push_back(i);
+    }
+    long sum = 0;
+    for (int i = 0; i < ops; ++i) {
+        sum += list.front();
+        list.pop_front();
+        list.push_back(i);
+    }
+    bench::do_not_optimize(sum);
+}
+
+// Time only the destructor of an n-element list
+template <typename List, typename Fill>
+double destroy_ms(int n, Fill fill) {
+    auto* list = new List;
+    fill(*list, n);
+    auto start = std::chrono::steady_clock::now();
+    delete list;
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+void report_ms(const std::string& name, double ms) {
+    std::cout << std::left << std::setw(48) << name << std::right << std::setw(10)
+              << std::fixed << std::setprecision(1) << ms << " ms\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 10'000'000;
+    int ops = n / 2;
+
+    std::cout << "push/pop churn, 1000 live nodes, " << ops << " cycles\n";
+    bench::report("LinkedList<int> (pooled)", bench::measure(ops, [&] {
+        LinkedList<int> list;
+        churn(list, 1000, ops);
+    }));
+    bench::report("std::list<int>", bench::measure(ops, [&] {
+        std::list<int> list;
+        churn(list, 1000, ops);
+    }));
+
+    std::cout << "\ndestroying a " << n << "-node list\n";
+    auto fill_back = [](auto& list, int count) {
+        for (int i = 0; i < count; ++i) list.push_back(i);
+    };
+    auto fill_front = [](auto& list, int count) {
+        for (int i = 0; i < count; ++i) list.push_front(i);
+    };
+    auto fill_strings = [](auto& list, int count) {
+        for (int i = 0; i < count; ++i) list.push_back(std::string(24, 'x'));
+    };
+    report_ms("LinkedList<int>", destroy_ms<LinkedList<int>>(n, fill_back));
+    report_ms("std::list<int>", destroy_ms<std::list<int>>(n, fill_back));
+    report_ms("std::forward_list<int>", destroy_ms<std::forward_list<int>>(n, fill_front));
+    report_ms("LinkedList<std::string> (24 chars)", destroy_ms<LinkedList<std::string>>(n, fill_strings));
+    report_ms("std::list<std::string> (24 chars)", destroy_ms<std::list<std::string>>(n, fill_strings));
+
+    return 0;
+}
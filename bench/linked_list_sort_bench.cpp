@@ -0,0 +1,103 @@
+// linked_list_sort_bench.cpp
+// In-place merge sort and O(1) splicing against the copy into a vector,
+// sort, rebuild approach.
+#include <algorithm>
+#include <cstdlib>
+#include <list>
+#include <random>
+#include <vector>
+#include "bench_timer.hpp"
+#include "../linkedlist_code/linked_list.hpp"
+
+namespace {
+
+std::vector<int> random_values(int n) {
+    std::mt19937 rng(7);
+    std::vector<int> values(n);
+    for (int& v : values) {
+        v = static_cast<int>(rng());
+    }
+    return values;
+}
+
+template <typename List>
+List build(const std::vector<int>& values) {
+    List list;
+    for (int v : values) {
+        list.push_back(v);
+    }
+    return list;
+}
+
+void copy_sort_rebuild(LinkedList<int>& list) {
+    std::vector<int> scratch(list.begin(), list.end());
+    std::stable_sort(scratch.begin(), scratch.end());
+    list.clear();
+    for (int v : scratch) {
+        list.push_back(v);
+    }
+}
+
+// Sorting consumes its input, so each repetition sorts a fresh copy;
+// the copy is made outside the timed region
+template <typename List, typename Sort>
+double time_sort(const std::vector<int>& values, Sort sort) {
+    double best = 0.0;
+    for (int r = 0; r < 3; ++r) {
+        List list = build<List>(values);
+        double ns = bench::measure(values.size(), [&] { sort(list); }, 1);
+        if (r == 0 || ns < best) {
+            best = ns;
+        }
+        bench::do_not_optimize(list.front());
+    }
+    return best;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes;
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(std::atoi(argv[i]));
+    }
+    if (sizes.empty()) {
+        sizes = {1'000'000, 10'000'000};
+    }
+
+    for (int n : sizes) {
+        std::vector<int> values = random_values(n);
+        std::cout << "sorting " << n << " random ints\n";
+        bench::report("LinkedList::sort", time_sort<LinkedList<int>>(values, [](auto& l) { l.sort(); }));
+        bench::report("copy -> stable_sort -> rebuild", time_sort<LinkedList<int>>(values, copy_sort_rebuild));
+        bench::report("std::list::sort", time_sort<std::list<int>>(values, [](auto& l) { l.sort(); }));
+
+        // Concatenate n / 1000 lists of 1000 elements each; the pieces are
+        // rebuilt outside the timed region for every repetition
+        int parts = std::max(1, n / 1000);
+        std::cout << "concatenating " << parts << " lists of 1000\n";
+        std::vector<int> chunk(values.begin(), values.begin() + std::min(n, 1000));
+        auto time_concat = [&](auto concat) {
+            double best = 0.0;
+            for (int r = 0; r < 3; ++r) {
+                std::vector<LinkedList<int>> pieces;
+                for (int p = 0; p < parts; ++p) pieces.push_back(build<LinkedList<int>>(chunk));
+                LinkedList<int> all;
+                double ns = bench::measure(static_cast<size_t>(parts), [&] { concat(all, pieces); }, 1);
+                bench::do_not_optimize(all.size());
+                best = r == 0 ? ns : std::min(best, ns);
+            }
+            return best;
+        };
+        bench::report("LinkedList::append (splice)", time_concat([](auto& all, auto& pieces) {
+            for (auto& piece : pieces) all.append(piece);
+        }));
+        bench::report("element-wise copy", time_concat([](auto& all, auto& pieces) {
+            for (auto& piece : pieces) {
+                for (int v : piece) all.push_back(v);
+            }
+        }));
+        std::cout << '\n';
+    }
+    return 0;
+}
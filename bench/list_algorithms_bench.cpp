@@ -0,0 +1,62 @@
+// list_algorithms_bench.cpp
+// Template-callable and parallel for_each/transform/reduce over LinkedList
+// against the std::function-based loop the list used to have.
+#include <cstdlib>
+#include <functional>
+#include <thread>
+#include "bench_timer.hpp"
+#include "../linkedlist_code/list_algorithms.hpp"
+
+namespace {
+
+// What LinkedList::for_each did before it became a template
+void for_each_function(LinkedList<int>& list, const std::function<void(int&)>& func) {
+    for (auto& item : list) {
+        func(item);
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 10'000'000;
+    unsigned threads = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2]))
+                                : std::max(2u, std::thread::hardware_concurrency());
+
+    LinkedList<int> numbers;
+    for (int i = 0; i < n; ++i) {
+        numbers.push_back(i & 1023);
+    }
+    auto par = list_exec::par.with_threads(threads);
+    ListChunkIndex index(numbers, threads);
+
+    std::cout << n << " elements, parallel runs use " << threads << " threads\n";
+    bench::report("for_each std::function n *= 2", bench::measure(n, [&] {
+        for_each_function(numbers, [](int& v) { v *= 2; });
+    }));
+    bench::report("LinkedList::for_each n *= 2", bench::measure(n, [&] {
+        numbers.for_each([](int& v) { v *= 2; });
+    }));
+    bench::report("for_each(seq) n *= 2", bench::measure(n, [&] {
+        for_each(list_exec::seq, numbers, [](int& v) { v *= 2; });
+    }));
+    bench::report("for_each(par) n *= 2", bench::measure(n, [&] {
+        for_each(par, numbers, [](int& v) { v *= 2; });
+    }));
+    bench::report("for_each(par, index) n *= 2", bench::measure(n, [&] {
+        for_each(par, numbers, index, [](int& v) { v *= 2; });
+    }));
+    bench::report("transform(seq) n + 1", bench::measure(n, [&] {
+        transform(list_exec::seq, numbers, [](int v) { return v + 1; });
+    }));
+    bench::report("transform(par, index) n + 1", bench::measure(n, [&] {
+        transform(par, numbers, index, [](int v) { return v + 1; });
+    }));
+    bench::report("reduce(seq) sum", bench::measure(n, [&] {
+        bench::do_not_optimize(reduce(list_exec::seq, numbers, 0L));
+    }));
+    bench::report("reduce(par, index) sum", bench::measure(n, [&] {
+        bench::do_not_optimize(reduce(par, numbers, index, 0L));
+    }));
+    return 0;
+}
@@ -0,0 +1,107 @@
+// quantile_sketch_bench.cpp
+// TDigest and LogLinearHistogram: update rate, merge cost, serialized size
+// and accuracy against exact quantiles of the same readings.
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include "bench_timer.hpp"
+#include "../memory_manage/quantile_sketch.hpp"
+
+namespace {
+
+// Mostly normal around room temperature with a heavy hot tail (1% of
+// readings from a lognormal excursion), so p99.9 is far from the mean
+std::vector<float> make_readings(size_t n) {
+    std::mt19937_64 rng(12345);
+    std::normal_distribution<double> room(22.0, 2.0);
+    std::lognormal_distribution<double> excursion(2.0, 0.8);
+    std::uniform_int_distribution<int> pick(0, 99);
+    std::vector<float> values(n);
+    for (auto& v : values) {
+        v = static_cast<float>(pick(rng) == 0 ? 30.0 + excursion(rng) : room(rng));
+    }
+    return values;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t readings = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    int shards = argc > 2 ? std::atoi(argv[2]) : 1000;
+    std::vector<float> values = make_readings(readings);
+    std::cout << readings << " readings, " << shards << " shards to merge\n";
+
+    TDigest digest;
+    bench::report("TDigest::add", bench::measure(readings, [&] {
+        digest = TDigest();
+        for (float v : values) {
+            digest.add(v);
+        }
+        bench::do_not_optimize(digest.quantile(0.5));
+    }, 3));
+    LogLinearHistogram histogram;
+    bench::report("LogLinearHistogram::add", bench::measure(readings, [&] {
+        histogram = LogLinearHistogram();
+        for (float v : values) {
+            histogram.add(v);
+        }
+        bench::do_not_optimize(histogram.count());
+    }, 3));
+
+    // One sketch per shard (sensor or thread), then a fleet-wide merge
+    std::vector<TDigest> digest_shards(shards);
+    std::vector<LogLinearHistogram> histogram_shards(shards);
+    for (size_t i = 0; i < readings; ++i) {
+        digest_shards[i % shards].add(values[i]);
+        histogram_shards[i % shards].add(values[i]);
+    }
+    TDigest merged_digest;
+    bench::report("TDigest::merge per shard", bench::measure(shards, [&] {
+        merged_digest = TDigest();
+        for (const auto& shard : digest_shards) {
+            merged_digest.merge(shard);
+        }
+        bench::do_not_optimize(merged_digest.quantile(0.99));
+    }));
+    LogLinearHistogram merged_histogram;
+    bench::report("LogLinearHistogram::merge per shard", bench::measure(shards, [&] {
+        merged_histogram = LogLinearHistogram();
+        for (const auto& shard : histogram_shards) {
+            merged_histogram.merge(shard);
+        }
+        bench::do_not_optimize(merged_histogram.quantile(0.99));
+    }));
+
+    std::cout << "serialized: TDigest " << merged_digest.serialize().size() << " bytes ("
+              << merged_digest.centroid_count() << " centroids), LogLinearHistogram "
+              << merged_histogram.serialize().size() << " bytes, raw readings "
+              << readings * sizeof(float) << " bytes\n";
+
+    double sort_ns = bench::measure(readings, [&] {
+        std::vector<float> copy = values;
+        std::nth_element(copy.begin(), copy.begin() + copy.size() / 2, copy.end());
+        bench::do_not_optimize(copy[copy.size() / 2]);
+    }, 1);
+    bench::report("exact p50 (copy + nth_element)", sort_ns);
+
+    std::sort(values.begin(), values.end());
+    std::cout << "\n" << std::setw(8) << "q" << std::setw(12) << "exact" << std::setw(12) << "t-digest"
+              << std::setw(10) << "err" << std::setw(12) << "merged td" << std::setw(12) << "histogram"
+              << std::setw(10) << "err\n";
+    for (double q : {0.5, 0.9, 0.99, 0.999, 0.9999}) {
+        double exact = values[static_cast<size_t>(std::ceil(q * readings)) - 1];
+        double td = digest.quantile(q);
+        double hist = histogram.quantile(q);
+        std::cout << std::defaultfloat << std::setprecision(5) << std::setw(8) << q
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(12) << exact << std::setw(12) << td
+                  << std::setw(9) << std::setprecision(2) << 100 * std::fabs(td - exact) / exact << "%"
+                  << std::setprecision(3) << std::setw(12) << merged_digest.quantile(q)
+                  << std::setw(12) << hist
+                  << std::setw(9) << std::setprecision(2) << 100 * std::fabs(hist - exact) / exact << "%\n";
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+// rollup_tiers_bench.cpp
+// Time-range aggregates over a year of one sensor's history: the rollup
+// query planner (1 s / 1 min / 1 h tiers plus raw edges) against scanning
+// the raw readings, for year-long, month-long and hour-long ranges with
+// unaligned endpoints.
+//
+// usage: rollup_tiers_bench [days] [sample interval ms] [queries]
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "bench_timer.hpp"
+#include "../memory_manage/rollup_tiers.hpp"
+
+namespace {
+
+struct Range {
+    std::int64_t from;
+    std::int64_t to;
+};
+
+// Random ranges of `length` ms at unaligned offsets inside [start, end)
+std::vector<Range> make_ranges(std::int64_t start, std::int64_t end, std::int64_t length, int count) {
+    std::mt19937_64 rng(length);
+    std::vector<Range> ranges;
+    std::int64_t slack = std::max<std::int64_t>(end - start - length, 1);
+    for (int i = 0; i < count; ++i) {
+        std::int64_t from = start + static_cast<std::int64_t>(rng() % slack);
+        ranges.push_back({from, from + length});
+    }
+    return ranges;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int days = argc > 1 ? std::atoi(argv[1]) : 365;
+    std::int64_t interval = argc > 2 ? std::atoll(argv[2]) : 1000;
+    int queries = argc > 3 ? std::atoi(argv[3]) : 20;
+
+    const std::int64_t day = 86'400'000;
+    const std::int64_t start = 1'700'000'000'123;  // ms, deliberately not on a second boundary
+    const std::int64_t end = start + days * day;
+    size_t readings = static_cast<size_t>((end - start) / interval);
+
+    RollupSeries series;
+    std::mt19937 rng(7);
+    std::normal_distribution<float> noise(0.0f, 0.2f);
+    double append_ns = bench::measure(readings, [&] {
+        series = RollupSeries();
+        for (size_t i = 0; i < readings; ++i) {
+            std::int64_t t = start + static_cast<std::int64_t>(i) * interval;
+            float swing = 3.0f * std::sin(static_cast<float>(t % day) * 7.27e-8f);
+            series.append(t, 21.0f + swing + noise(rng));
+        }
+    }, 1);
+    bench::report("append (raw + 3 tiers)", append_ns);
+    std::cout << readings << " readings over " << days << " days, " << series.memory_usage() / 1e6
+              << " MB; buckets per tier:";
+    for (size_t t = 0; t < series.tier_count(); ++t) {
+        std::cout << " " << series.bucket_count(t);
+    }
+    std::cout << "\n";
+
+    struct Case {
+        const char* name;
+        std::int64_t length;
+    };
+    for (Case c : {Case{"year", days * day - 7 * day - 12'345},
+                   Case{"month", 30 * day + 4'567},
+                   Case{"hour", 3'600'000 + 891}}) {
+        std::vector<Range> ranges = make_ranges(start, end, c.length, queries);
+        RollupQueryCost cost;
+        double rollup_ns = bench::measure(ranges.size(), [&] {
+            cost = RollupQueryCost();
+            for (const Range& r : ranges) {
+                bench::do_not_optimize(series.aggregate(r.from, r.to, &cost).sum);
+            }
+        });
+        double raw_ns = bench::measure(ranges.size(), [&] {
+            for (const Range& r : ranges) {
+                bench::do_not_optimize(series.aggregate_raw(r.from, r.to).sum);
+            }
+        }, 1);
+        std::string label = std::string(c.name) + " range, ";
+        bench::report(label + "rollup planner", rollup_ns);
+        bench::report(label + "raw scan", raw_ns);
+        std::cout << "  per query: " << cost.buckets / ranges.size() << " buckets + "
+                  << cost.raw_readings / ranges.size() << " raw readings, speedup "
+                  << std::setprecision(0) << raw_ns / rollup_ns << "x\n";
+    }
+    return 0;
+}
@@ -0,0 +1,248 @@
+// serialization_bench.cpp
+// Binary Encoder/Decoder round trips of each container against the naive
+// approach: format every element into a std::stringstream with << and
+// parse it back with >>. Throughput is in GB/s of binary payload for both,
+// so the columns compare directly. The naive Queue and Map paths format
+// the source values and rebuild through enqueue/put, as a caller without
+// access to the storage would.
+//
+// usage: serialization_bench [elements, default 4M]
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "bench_timer.hpp"
+#include "../queue_code/Queue.hpp"
+#include "../map_code/Map.hpp"
+#include "../stack_code/stack_mod.hpp"
+#include "../linkedlist_code/linked_list.hpp"
+
+namespace {
+
+using serialization::Decoder;
+using serialization::Encoder;
+
+template <typename Container>
+void encode(const Container& c, std::vector<std::byte>& bytes) {
+    bytes.clear();
+    Encoder out(serialization::vector_sink(bytes));
+    out.write(c);
+    out.flush();
+}
+
+void row(const std::string& name, double bytes, double save_ns, double load_ns, double naive_save_ns,
+         double naive_load_ns) {
+    std::cout << std::left << std::setw(30) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << bytes / save_ns << std::setw(10) << bytes / load_ns
+              << std::setw(12) << bytes / naive_save_ns << std::setw(12) << bytes / naive_load_ns << "\n";
+}
+
+// Times binary save/load of `source` into a fresh container
+template <typename Container>
+std::pair<double, double> time_binary(const Container& source, std::vector<std::byte>& bytes) {
+    double save = bench::measure(1, [&] {
+        encode(source, bytes);
+        bench::do_not_optimize(bytes.data());
+    }, 3);
+    double load = bench::measure(1, [&] {
+        Container copy;
+        Decoder in(serialization::span_source(bytes));
+        in.read(copy);
+        bench::do_not_optimize(copy);
+    }, 3);
+    return {save, load};
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4'000'000;
+    std::vector<std::byte> bytes;
+    bytes.reserve(n * 48);
+    std::cout << std::left << std::setw(30) << "GB/s" << std::right << std::setw(10) << "save" << std::setw(10)
+              << "load" << std::setw(12) << "naive save" << std::setw(12) << "naive load" << "\n";
+
+    {
+        std::vector<int> values(n);
+        Queue<int> queue;
+        for (size_t i = 0; i < n; ++i) {
+            values[i] = static_cast<int>(i * 2654435761u);
+            queue.enqueue(values[i]);
+        }
+        auto [save, load] = time_binary(queue, bytes);
+        double naive_save = bench::measure(1, [&] {
+            std::stringstream text;
+            for (int v : values) {
+                text << v << '\n';
+            }
+            bench::do_not_optimize(text);
+        }, 3);
+        std::stringstream text;
+        for (int v : values) {
+            text << v << '\n';
+        }
+        double naive_load = bench::measure(1, [&] {
+            std::stringstream in(text.str());
+            Queue<int> copy;
+            int v;
+            while (in >> v) {
+                copy.enqueue(v);
+            }
+            bench::do_not_optimize(copy);
+        }, 3);
+        row("Queue<int>", static_cast<double>(bytes.size()), save, load, naive_save, naive_load);
+    }
+
+    {
+        // Map::put scans every entry, so the table stays small
+        size_t entries = std::min<size_t>(n, 10'000);
+        Map<int, double> map;
+        for (size_t i = 0; i < entries; ++i) {
+            map.put(static_cast<int>(i), i * 0.5);
+        }
+        auto [save, load] = time_binary(map, bytes);
+        auto format = [&](std::stringstream& text) {
+            std::vector<int> keys = map.getKeys();
+            std::vector<double> values = map.getValues();
+            text << std::setprecision(17);
+            for (size_t i = 0; i < keys.size(); ++i) {
+                text << keys[i] << ' ' << values[i] << '\n';
+            }
+        };
+        double naive_save = bench::measure(1, [&] {
+            std::stringstream text;
+            format(text);
+            bench::do_not_optimize(text);
+        }, 3);
+        std::stringstream text;
+        format(text);
+        double naive_load = bench::measure(1, [&] {
+            std::stringstream in(text.str());
+            Map<int, double> copy;
+            int k;
+            double v;
+            while (in >> k >> v) {
+                copy.put(k, v);
+            }
+            bench::do_not_optimize(copy);
+        }, 3);
+        row("Map<int, double> (10k)", static_cast<double>(bytes.size()), save, load, naive_save, naive_load);
+    }
+
+    {
+        // Stack capacity is capped at 1000, so time many small stacks
+        const int rounds = 2'000;
+        Stack<double> stack(1000);
+        for (int i = 0; i < 1000; ++i) {
+            stack.push(i * 0.25);
+        }
+        std::vector<double> values;
+        for (int i = 0; i < 1000; ++i) {
+            values.push_back(i * 0.25);
+        }
+        encode(stack, bytes);
+        double total = static_cast<double>(bytes.size()) * rounds;
+        double save = bench::measure(1, [&] {
+            for (int r = 0; r < rounds; ++r) {
+                encode(stack, bytes);
+            }
+            bench::do_not_optimize(bytes.data());
+        }, 3);
+        double load = bench::measure(1, [&] {
+            for (int r = 0; r < rounds; ++r) {
+                Stack<double> copy;
+                Decoder in(serialization::span_source(bytes), 4096);
+                in.read(copy);
+                bench::do_not_optimize(copy);
+            }
+        }, 3);
+        std::string formatted;
+        double naive_save = bench::measure(1, [&] {
+            for (int r = 0; r < rounds; ++r) {
+                std::stringstream text;
+                text << std::setprecision(17);
+                for (double v : values) {
+                    text << v << '\n';
+                }
+                formatted = text.str();
+            }
+            bench::do_not_optimize(formatted);
+        }, 3);
+        double naive_load = bench::measure(1, [&] {
+            for (int r = 0; r < rounds; ++r) {
+                std::stringstream in(formatted);
+                Stack<double> copy(1000);
+                double v;
+                while (in >> v) {
+                    copy.push(v);
+                }
+                bench::do_not_optimize(copy);
+            }
+        }, 3);
+        row("Stack<double> (1000) x 2000", total, save, load, naive_save, naive_load);
+    }
+
+    {
+        LinkedList<double> list;
+        for (size_t i = 0; i < n; ++i) {
+            list.push_back(i * 0.001);
+        }
+        auto [save, load] = time_binary(list, bytes);
+        auto format = [&](std::stringstream& text) {
+            text << std::setprecision(17);
+            for (double v : list) {
+                text << v << '\n';
+            }
+        };
+        double naive_save = bench::measure(1, [&] {
+            std::stringstream text;
+            format(text);
+            bench::do_not_optimize(text);
+        }, 3);
+        std::stringstream text;
+        format(text);
+        double naive_load = bench::measure(1, [&] {
+            std::stringstream in(text.str());
+            LinkedList<double> copy;
+            double v;
+            while (in >> v) {
+                copy.push_back(v);
+            }
+            bench::do_not_optimize(copy);
+        }, 3);
+        row("LinkedList<double>", static_cast<double>(bytes.size()), save, load, naive_save, naive_load);
+    }
+
+    {
+        LinkedList<std::string> list;
+        for (size_t i = 0; i < n / 4; ++i) {
+            list.push_back("sensor-" + std::to_string(i * 7919) + "/temperature");
+        }
+        auto [save, load] = time_binary(list, bytes);
+        // Names have no spaces, so >> reads them back whole
+        auto format = [&](std::stringstream& text) {
+            for (const std::string& s : list) {
+                text << s << '\n';
+            }
+        };
+        double naive_save = bench::measure(1, [&] {
+            std::stringstream text;
+            format(text);
+            bench::do_not_optimize(text);
+        }, 3);
+        std::stringstream text;
+        format(text);
+        double naive_load = bench::measure(1, [&] {
+            std::stringstream in(text.str());
+            LinkedList<std::string> copy;
+            std::string s;
+            while (in >> s) {
+                copy.push_back(s);
+            }
+            bench::do_not_optimize(copy);
+        }, 3);
+        row("LinkedList<std::string>", static_cast<double>(bytes.size()), save, load, naive_save, naive_load);
+    }
+    return 0;
+}
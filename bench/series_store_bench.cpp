@@ -0,0 +1,125 @@
+// series_store_bench.cpp
+// Per-sensor aggregation over the three layouts in memory_manage/main.cpp
+// (float**, vector<vector<float>>, map<int, shared_ptr<vector<float>>>)
+// against SensorSeriesStore with scalar and AVX2 kernels.
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <vector>
+#include "bench_timer.hpp"
+#include "../memory_manage/series_store.hpp"
+
+namespace {
+
+float reading(int sensor, int j) {
+    return 20.0f + sensor * 1.5f + static_cast<float>((sensor * 7919 + j * 104729) % 10) / 10.0f;
+}
+
+// The summing loop of DataAnalyzer::calculateAverage
+float naive_average(const float* values, size_t n) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        sum += values[i];
+    }
+    return sum / n;
+}
+
+// Straightforward scalar mean/min/max/variance over one whole series
+SeriesStats naive_stats(const float* values, size_t n) {
+    return series_kernels::stats_scalar(values, n);
+}
+
+template <typename Kernel>
+SeriesStats store_stats(const SensorSeriesStore& store, size_t sensor, Kernel kernel) {
+    SeriesStats total;
+    store.for_each_chunk(sensor, [&](const std::int64_t*, const float* values, size_t n) {
+        total.merge(kernel(values, n));
+    });
+    return total;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int sensors = argc > 1 ? std::atoi(argv[1]) : 1000;
+    int readings = argc > 2 ? std::atoi(argv[2]) : 10000;
+    size_t total = static_cast<size_t>(sensors) * readings;
+
+    float** raw = new float*[sensors];
+    std::vector<std::vector<float>> nested(sensors);
+    std::map<int, std::shared_ptr<std::vector<float>>> logged;
+    SensorSeriesStore store(sensors);
+    for (int i = 0; i < sensors; ++i) {
+        raw[i] = new float[readings];
+        nested[i].reserve(readings);
+        logged[i] = std::make_shared<std::vector<float>>();
+    }
+    // Interleaved by time, the order DataLogger::logReading sees them
+    for (int j = 0; j < readings; ++j) {
+        for (int i = 0; i < sensors; ++i) {
+            float value = reading(i, j);
+            raw[i][j] = value;
+            nested[i].push_back(value);
+            logged[i]->push_back(value);
+            store.append(i, j, value);
+        }
+    }
+
+    std::cout << sensors << " sensors x " << readings << " readings, AVX2 "
+              << (series_kernels::avx2_available() ? "available" : "unavailable") << "\n";
+
+    bench::report("float** average (float sum)", bench::measure(total, [&] {
+        for (int i = 0; i < sensors; ++i) {
+            bench::do_not_optimize(naive_average(raw[i], readings));
+        }
+    }));
+    bench::report("vector<vector> average (float sum)", bench::measure(total, [&] {
+        for (int i = 0; i < sensors; ++i) {
+            bench::do_not_optimize(naive_average(nested[i].data(), readings));
+        }
+    }));
+    bench::report("map<shared_ptr<vector>> average (float sum)", bench::measure(total, [&] {
+        for (const auto& [id, values] : logged) {
+            bench::do_not_optimize(naive_average(values->data(), values->size()));
+        }
+    }));
+
+    bench::report("float** full stats", bench::measure(total, [&] {
+        for (int i = 0; i < sensors; ++i) {
+            bench::do_not_optimize(naive_stats(raw[i], readings));
+        }
+    }));
+    bench::report("vector<vector> full stats", bench::measure(total, [&] {
+        for (int i = 0; i < sensors; ++i) {
+            bench::do_not_optimize(naive_stats(nested[i].data(), readings));
+        }
+    }));
+    bench::report("map<shared_ptr<vector>> full stats", bench::measure(total, [&] {
+        for (const auto& [id, values] : logged) {
+            bench::do_not_optimize(naive_stats(values->data(), values->size()));
+        }
+    }));
+    bench::report("SensorSeriesStore full stats, scalar", bench::measure(total, [&] {
+        for (int i = 0; i < sensors; ++i) {
+            bench::do_not_optimize(store_stats(store, i, series_kernels::stats_scalar));
+        }
+    }));
+#ifdef SERIES_STORE_HAVE_AVX2
+    if (series_kernels::avx2_available()) {
+        bench::report("SensorSeriesStore full stats, AVX2", bench::measure(total, [&] {
+            for (int i = 0; i < sensors; ++i) {
+                bench::do_not_optimize(store_stats(store, i, series_kernels::stats_avx2));
+            }
+        }));
+    }
+#endif
+    bench::report("SensorSeriesStore stats_all (dispatched)", bench::measure(total, [&] {
+        bench::do_not_optimize(store.stats_all());
+    }));
+
+    for (int i = 0; i < sensors; ++i) {
+        delete[] raw[i];
+    }
+    delete[] raw;
+    return 0;
+}
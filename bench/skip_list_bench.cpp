@@ -0,0 +1,141 @@
+// skip_list_bench.cpp
+// Concurrent ordered-set benchmark: ConcurrentSkipList against std::map behind a mutex.
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <map>
+#include <thread>
+#include <vector>
+#include "bench_timer.hpp"
+#include "../linkedlist_code/skip_list.hpp"
+
+namespace {
+
+class LockedMap {
+public:
+    bool insert(std::uint64_t key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return map.emplace(key, key).second;
+    }
+
+    bool contains(std::uint64_t key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return map.count(key) != 0;
+    }
+
+    std::uint64_t scan(std::uint64_t low, int count) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::uint64_t sum = 0;
+        for (auto it = map.lower_bound(low); it != map.end() && count-- > 0; ++it) {
+            sum += it->second;
+        }
+        return sum;
+    }
+
+private:
+    std::mutex mutex;
+    std::map<std::uint64_t, std::uint64_t> map;
+};
+
+class SkipSet {
+public:
+    bool insert(std::uint64_t key) { return list.insert(key); }
+    bool contains(std::uint64_t key) { return list.contains(key); }
+
+    std::uint64_t scan(std::uint64_t low, int count) {
+        std::uint64_t sum = 0;
+        for (auto it = list.lower_bound(low); it != list.end() && count-- > 0; ++it) {
+            sum += *it;
+        }
+        return sum;
+    }
+
+private:
+    ConcurrentSkipList<std::uint64_t> list;
+};
+
+std::uint64_t next_key(std::uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+template <typename Body>
+void run_threads(int threads, Body body) {
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back(body, t);
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+}
+
+// Every thread inserts its own stream of random keys into an empty set.
+// Each repetition gets a fresh set, built and torn down outside the timing.
+template <typename S>
+double run_inserts(int threads, int keys_per_thread) {
+    constexpr int reps = 3;
+    std::vector<std::unique_ptr<S>> sets;
+    for (int r = 0; r < reps; ++r) {
+        sets.push_back(std::make_unique<S>());
+    }
+    int rep = 0;
+    return bench::measure(static_cast<size_t>(threads) * keys_per_thread, [&] {
+        S& set = *sets[rep++];
+        run_threads(threads, [&set, keys_per_thread](int t) {
+            std::uint64_t state = 0x9E3779B97F4A7C15ull * (t + 1);
+            for (int i = 0; i < keys_per_thread; ++i) {
+                set.insert(next_key(state));
+            }
+        });
+    }, reps);
+}
+
+// Read-mostly mix on a prefilled set: 90% lookups, 9% inserts, 1% scans of 64 keys
+template <typename S>
+double run_mixed(int threads, int ops_per_thread, int prefill) {
+    S set;
+    std::uint64_t state = 42;
+    for (int i = 0; i < prefill; ++i) {
+        set.insert(next_key(state) % (prefill * 4ull));
+    }
+    return bench::measure(static_cast<size_t>(threads) * ops_per_thread, [&] {
+        run_threads(threads, [&set, ops_per_thread, prefill](int t) {
+            std::uint64_t state = 0xD1B54A32D192ED03ull * (t + 1);
+            std::uint64_t found = 0;
+            for (int i = 0; i < ops_per_thread; ++i) {
+                std::uint64_t key = next_key(state);
+                int choice = static_cast<int>(key % 100);
+                key = (key >> 8) % (prefill * 4ull);
+                if (choice < 90) {
+                    found += set.contains(key);
+                } else if (choice < 99) {
+                    set.insert(key);
+                } else {
+                    found += set.scan(key, 64);
+                }
+            }
+            bench::do_not_optimize(found);
+        });
+    }, 3);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int keys = argc > 1 ? std::atoi(argv[1]) : 400'000;
+    int ops = argc > 2 ? std::atoi(argv[2]) : 1'000'000;
+
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << "\n";
+    for (int threads : {1, 2, 4, 8}) {
+        std::string suffix = " x" + std::to_string(threads) + " threads";
+        bench::report("mutex + std::map insert" + suffix, run_inserts<LockedMap>(threads, keys / threads));
+        bench::report("ConcurrentSkipList insert" + suffix, run_inserts<SkipSet>(threads, keys / threads));
+        bench::report("mutex + std::map 90/9/1 mix" + suffix, run_mixed<LockedMap>(threads, ops / threads, keys));
+        bench::report("ConcurrentSkipList 90/9/1 mix" + suffix, run_mixed<SkipSet>(threads, ops / threads, keys));
+    }
+    return 0;
+}
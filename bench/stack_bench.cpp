@@ -0,0 +1,97 @@
+// stack_bench.cpp
+// Push/pop throughput of the stack variants against std::stack.
+#include <cstdlib>
+#include <deque>
+#include <stack>
+#include <vector>
+#include "bench_timer.hpp"
+#include "legacy_stack.hpp"
+#include "../stack_code/stack_mod.hpp"
+
+namespace {
+
+// Both existing Stack classes cap out at 1000 elements, so the shared
+// workload fills and drains the stack to that depth over and over.
+constexpr int depth = 1000;
+
+template <typename S>
+void fill_drain(S& s, int rounds) {
+    long sum = 0;
+    for (int r = 0; r < rounds; ++r) {
+        for (int i = 0; i < depth; ++i) {
+            s.push(i);
+        }
+        for (int i = 0; i < depth; ++i) {
+            sum += s.pop();
+        }
+    }
+    bench::do_not_optimize(sum);
+}
+
+template <typename S>
+void fill_drain_std(S& s, int rounds) {
+    long sum = 0;
+    for (int r = 0; r < rounds; ++r) {
+        for (int i = 0; i < depth; ++i) {
+            s.push(i);
+        }
+        for (int i = 0; i < depth; ++i) {
+            sum += s.top();
+            s.pop();
+        }
+    }
+    bench::do_not_optimize(sum);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 2000;
+    size_t ops = static_cast<size_t>(rounds) * depth * 2;
+
+    std::cout << "push/pop cycles to depth " << depth << ", " << rounds << " rounds\n";
+
+    bench::report("std::stack<int> (deque)", bench::measure(ops, [&] {
+        std::stack<int> s;
+        fill_drain_std(s, rounds);
+    }));
+    bench::report("std::stack<int> (vector)", bench::measure(ops, [&] {
+        std::stack<int, std::vector<int>> s;
+        fill_drain_std(s, rounds);
+    }));
+    bench::report("legacy Stack<int> (stack.h)", bench::measure(ops, [&] {
+        legacy_stack_fill_drain(depth, rounds);
+    }));
+    bench::report("Stack<int> (stack_mod.hpp)", bench::measure(ops, [&] {
+        Stack<int> s(depth);
+        fill_drain(s, rounds);
+    }));
+    bench::report("FixedStack<int, 1000>", bench::measure(ops, [&] {
+        FixedStack<int, depth> s;
+        fill_drain(s, rounds);
+    }));
+    bench::report("SmallStack<int, 16>", bench::measure(ops, [&] {
+        SmallStack<int, 16> s;
+        fill_drain(s, rounds);
+    }));
+
+    // Growth path: only the unbounded stacks can go this deep
+    constexpr int deep = 1'000'000;
+    std::cout << "\nsingle fill/drain to depth " << deep << " from empty\n";
+    bench::report("std::stack<int> (vector)", bench::measure(deep * 2, [&] {
+        std::stack<int, std::vector<int>> s;
+        for (int i = 0; i < deep; ++i) s.push(i);
+        long sum = 0;
+        while (!s.empty()) { sum += s.top(); s.pop(); }
+        bench::do_not_optimize(sum);
+    }));
+    bench::report("SmallStack<int, 16>", bench::measure(deep * 2, [&] {
+        SmallStack<int, 16> s;
+        for (int i = 0; i < deep; ++i) s.push(i);
+        long sum = 0;
+        while (auto v = s.try_pop()) sum += *v;
+        bench::do_not_optimize(sum);
+    }));
+
+    return 0;
+}
@@ -0,0 +1,269 @@
+// suite_bench.cpp
+// Regression suite over every container in the repo (Queue, Map, Stack,
+// LinkedList, Graph) and the sensor data layouts in memory_manage. Sizes
+// are fixed so runs are comparable; use --json to save results and
+// bench_compare to diff two runs.
+//
+// usage: bench_suite [--warmup N] [--reps N] [--filter TEXT] [--json PATH]
+#include <map>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "harness.hpp"
+#include "../queue_code/Queue.hpp"
+#include "../map_code/Map.hpp"
+#include "../stack_code/stack_mod.hpp"
+#include "../linkedlist_code/linked_list.hpp"
+#include "../graph_code/Graph.hpp"
+#include "../memory_manage/series_store.hpp"
+
+namespace {
+
+void queue_benchmarks(bench::Harness& h) {
+    const size_t n = 100'000;
+    h.run("queue/enqueue", n, [&] {
+        Queue<int> queue;
+        for (size_t i = 0; i < n; ++i) {
+            queue.enqueue(static_cast<int>(i));
+        }
+        bench::do_not_optimize(queue.size());
+    });
+
+    // dequeue erases from the front of a vector, so keep this one small
+    const size_t drain = 5'000;
+    Queue<int> queue;
+    h.run("queue/dequeue", drain, [&] {
+        for (size_t i = 0; i < drain; ++i) {
+            queue.enqueue(static_cast<int>(i));
+        }
+    }, [&] {
+        long sum = 0;
+        while (!queue.isEmpty()) {
+            sum += queue.front();
+            queue.dequeue();
+        }
+        bench::do_not_optimize(sum);
+    });
+}
+
+void map_benchmarks(bench::Harness& h) {
+    const int n = 1'000;
+    std::vector<std::string> keys;
+    for (int i = 0; i < n; ++i) {
+        keys.push_back("sensor-" + std::to_string(i * 7919 % n));
+    }
+    h.run("map/put", n, [&] {
+        Map<std::string, int> map;
+        for (int i = 0; i < n; ++i) {
+            map.put(keys[i], i);
+        }
+        bench::do_not_optimize(map.size());
+    });
+
+    Map<std::string, int> map;
+    for (int i = 0; i < n; ++i) {
+        map.put(keys[i], i);
+    }
+    h.run("map/get", n, [&] {
+        long sum = 0;
+        for (int i = n - 1; i >= 0; --i) {
+            sum += map.get(keys[i]);
+        }
+        bench::do_not_optimize(sum);
+    });
+}
+
+void stack_benchmarks(bench::Harness& h) {
+    const size_t n = 1'000;  // Stack's maximum capacity
+    const int rounds = 100;
+    h.run("stack/push_pop", n * rounds, [&] {
+        Stack<int> stack(n);
+        long sum = 0;
+        for (int r = 0; r < rounds; ++r) {
+            for (size_t i = 0; i < n; ++i) {
+                stack.push(static_cast<int>(i));
+            }
+            while (!stack.empty()) {
+                sum += stack.pop();
+            }
+        }
+        bench::do_not_optimize(sum);
+    });
+    h.run("stack/fixed_push_pop", n * rounds, [&] {
+        FixedStack<int, n> stack;
+        long sum = 0;
+        for (int r = 0; r < rounds; ++r) {
+            for (size_t i = 0; i < n; ++i) {
+                stack.push(static_cast<int>(i));
+            }
+            while (!stack.empty()) {
+                sum += stack.pop();
+            }
+        }
+        bench::do_not_optimize(sum);
+    });
+    h.run("stack/small_push_pop", n * rounds, [&] {
+        SmallStack<int> stack;
+        long sum = 0;
+        for (int r = 0; r < rounds; ++r) {
+            for (size_t i = 0; i < n; ++i) {
+                stack.push(static_cast<int>(i));
+            }
+            while (!stack.empty()) {
+                sum += stack.pop();
+            }
+        }
+        bench::do_not_optimize(sum);
+    });
+}
+
+void linked_list_benchmarks(bench::Harness& h) {
+    const int n = 100'000;
+    h.run("linked_list/push_back", n, [&] {
+        LinkedList<int> list;
+        for (int i = 0; i < n; ++i) {
+            list.push_back(i);
+        }
+        bench::do_not_optimize(list.size());
+    });
+
+    LinkedList<int> list;
+    for (int i = 0; i < n; ++i) {
+        list.push_back(i * 7919 % n);
+    }
+    h.run("linked_list/iterate", n, [&] {
+        long sum = 0;
+        for (int v : list) {
+            sum += v;
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    LinkedList<int> unsorted;
+    h.run("linked_list/sort", n, [&] {
+        unsorted = list;
+    }, [&] {
+        unsorted.sort();
+        bench::do_not_optimize(unsorted.size());
+    });
+}
+
+void graph_benchmarks(bench::Harness& h) {
+    const int places = 2'000;
+    const int degree = 4;
+    std::vector<std::string> names;
+    for (int i = 0; i < places; ++i) {
+        names.push_back("place-" + std::to_string(i));
+    }
+    auto build = [&](Graph& graph) {
+        for (int i = 0; i < places; ++i) {
+            for (int d = 1; d <= degree; ++d) {
+                graph.addPath(names[i], names[(i * 31 + d * 97) % places]);
+            }
+        }
+    };
+    h.run("graph/add_path", places * degree, [&] {
+        Graph graph;
+        build(graph);
+        bench::do_not_optimize(graph.countPaths(names[0]));
+    });
+
+    Graph graph;
+    build(graph);
+    h.run("graph/has_direct_path", places * degree, [&] {
+        int found = 0;
+        for (int i = 0; i < places; ++i) {
+            for (int d = 1; d <= degree; ++d) {
+                found += graph.hasDirectPath(names[i], names[(i * 17 + d) % places]);
+            }
+        }
+        bench::do_not_optimize(found);
+    });
+}
+
+// The per-sensor average over the layouts in memory_manage/main.cpp
+void sensor_layout_benchmarks(bench::Harness& h) {
+    const int sensors = 100;
+    const int readings = 10'000;
+    const size_t total = static_cast<size_t>(sensors) * readings;
+    auto value = [](int sensor, int j) {
+        return 20.0f + sensor * 0.5f + static_cast<float>((sensor * 7919 + j * 104729) % 10) / 10.0f;
+    };
+
+    std::vector<std::unique_ptr<float[]>> raw_storage;
+    std::vector<float*> raw;
+    std::vector<std::vector<float>> nested(sensors);
+    std::map<int, std::shared_ptr<std::vector<float>>> logged;
+    SensorSeriesStore store(sensors);
+    for (int i = 0; i < sensors; ++i) {
+        raw_storage.push_back(std::make_unique<float[]>(readings));
+        raw.push_back(raw_storage.back().get());
+        logged[i] = std::make_shared<std::vector<float>>();
+    }
+    for (int j = 0; j < readings; ++j) {
+        for (int i = 0; i < sensors; ++i) {
+            float v = value(i, j);
+            raw[i][j] = v;
+            nested[i].push_back(v);
+            logged[i]->push_back(v);
+            store.append(i, j, v);
+        }
+    }
+
+    auto average = [](const float* values, size_t n) {
+        float sum = 0.0f;
+        for (size_t i = 0; i < n; ++i) {
+            sum += values[i];
+        }
+        return sum / n;
+    };
+    h.run("sensors/average_raw_pointers", total, [&] {
+        float acc = 0.0f;
+        for (int i = 0; i < sensors; ++i) {
+            acc += average(raw[i], readings);
+        }
+        bench::do_not_optimize(acc);
+    });
+    h.run("sensors/average_nested_vectors", total, [&] {
+        float acc = 0.0f;
+        for (const auto& series : nested) {
+            acc += average(series.data(), series.size());
+        }
+        bench::do_not_optimize(acc);
+    });
+    h.run("sensors/average_map_shared_ptr", total, [&] {
+        float acc = 0.0f;
+        for (const auto& [id, series] : logged) {
+            acc += average(series->data(), series->size());
+        }
+        bench::do_not_optimize(acc);
+    });
+    h.run("sensors/stats_series_store", total, [&] {
+        double acc = 0.0;
+        for (const SeriesStats& s : store.stats_each()) {
+            acc += s.mean();
+        }
+        bench::do_not_optimize(acc);
+    });
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bench::Options options;
+    try {
+        options = bench::parse_options(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+    bench::Harness harness(options);
+    queue_benchmarks(harness);
+    map_benchmarks(harness);
+    stack_benchmarks(harness);
+    linked_list_benchmarks(harness);
+    graph_benchmarks(harness);
+    sensor_layout_benchmarks(harness);
+    return harness.finish();
+}
@@ -0,0 +1,139 @@
+// temperature_sensor_bench.cpp
+// Synthetic reading generation: the old rand()-based sensor against the
+// Philox sensor, one reading per call and in batches through the scalar and
+// AVX2 kernels, then readings/sec as threads are added. rand() serializes
+// on glibc's internal lock; the Philox sensors share nothing.
+//
+// usage: temperature_sensor_bench [readings per thread, default 4M] [max threads]
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include "bench_timer.hpp"
+#include "../memory_manage/temperature_sensor.hpp"
+
+namespace {
+
+// The generator TemperatureSensor used before
+struct RandSensor {
+    int sensorId;
+    float readTemperature() const {
+        return 20.0f + (sensorId * 1.5f) + (rand() % 10) / 10.0f;
+    }
+};
+
+constexpr int sensorsPerThread = 64;
+constexpr size_t batch = 256;
+
+// Each thread polls its own sensors round-robin until it has produced
+// `readings`; returns aggregate readings per second
+template <typename Work>
+double throughput(unsigned threads, size_t readings, Work work) {
+    std::vector<std::thread> pool;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] { work(t, readings); });
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return threads * readings / seconds;
+}
+
+void rand_work(unsigned t, size_t readings) {
+    std::vector<RandSensor> sensors;
+    for (int i = 0; i < sensorsPerThread; ++i) {
+        sensors.push_back({static_cast<int>(t * sensorsPerThread + i)});
+    }
+    float sum = 0.0f;
+    for (size_t i = 0; i < readings; ++i) {
+        sum += sensors[i % sensorsPerThread].readTemperature();
+    }
+    bench::do_not_optimize(sum);
+}
+
+void philox_work(unsigned t, size_t readings) {
+    std::vector<TemperatureSensor> sensors;
+    for (int i = 0; i < sensorsPerThread; ++i) {
+        sensors.emplace_back(static_cast<int>(t * sensorsPerThread + i));
+    }
+    std::vector<float> buffer(batch);
+    float sum = 0.0f;
+    for (size_t i = 0; i < readings; i += batch) {
+        sensors[i / batch % sensorsPerThread].readTemperatures(buffer);
+        sum += buffer[0];
+    }
+    bench::do_not_optimize(sum);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4'000'000;
+    unsigned maxThreads = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2]))
+                                   : std::max(4u, std::thread::hardware_concurrency());
+    n -= n % batch;
+    std::cout << "AVX2 kernel " << (philox::avx2_available() ? "available" : "unavailable")
+              << ", " << std::thread::hardware_concurrency() << " hardware threads\n";
+
+    RandSensor legacy{3};
+    bench::report("rand() readTemperature", bench::measure(n, [&] {
+        float sum = 0.0f;
+        for (size_t i = 0; i < n; ++i) {
+            sum += legacy.readTemperature();
+        }
+        bench::do_not_optimize(sum);
+    }));
+
+    TemperatureSensor sensor(3);
+    bench::report("Philox readTemperature", bench::measure(n, [&] {
+        float sum = 0.0f;
+        for (size_t i = 0; i < n; ++i) {
+            sum += sensor.readTemperature();
+        }
+        bench::do_not_optimize(sum);
+    }));
+
+    std::vector<float> buffer(batch);
+    sensor_kernels::ReadingParams params;
+    params.key = philox::make_key(TemperatureSensor::defaultSeed);
+    params.sensor = 3;
+    params.baseline = 24.95f;
+    params.noise = 0.29f;
+    bench::report("Philox batch, scalar kernel", bench::measure(n, [&] {
+        for (size_t i = 0; i < n; i += batch) {
+            sensor_kernels::fill_scalar(params, i, buffer.data(), batch);
+            bench::do_not_optimize(buffer[0]);
+        }
+    }));
+    bench::report("Philox readTemperatures (dispatch)", bench::measure(n, [&] {
+        for (size_t i = 0; i < n; i += batch) {
+            sensor.readTemperatures(buffer);
+            bench::do_not_optimize(buffer[0]);
+        }
+    }));
+
+    SensorModel faulty;
+    faulty.driftPerReading = 1e-6f;
+    faulty.faultRate = 0.01;
+    TemperatureSensor noisy(3, faulty);
+    bench::report("Philox readTemperatures, drift + 1% spikes", bench::measure(n, [&] {
+        for (size_t i = 0; i < n; i += batch) {
+            noisy.readTemperatures(buffer);
+            bench::do_not_optimize(buffer[0]);
+        }
+    }));
+
+    std::cout << "\nthreads   rand() Mreadings/s   Philox batch Mreadings/s   per thread\n";
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        double legacyRate = throughput(threads, n / 4, rand_work);
+        double philoxRate = throughput(threads, n, philox_work);
+        std::cout << std::setw(7) << threads << std::fixed << std::setprecision(1)
+                  << std::setw(22) << legacyRate / 1e6 << std::setw(27) << philoxRate / 1e6
+                  << std::setw(13) << philoxRate / threads / 1e6 << "\n";
+    }
+    return 0;
+}
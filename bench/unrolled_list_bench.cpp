@@ -0,0 +1,82 @@
+// unrolled_list_bench.cpp
+// Traversal, find and mixed-update throughput of UnrolledList against
+// LinkedList and std::list.
+#include <algorithm>
+#include <cstdlib>
+#include <list>
+#include <random>
+#include "bench_timer.hpp"
+#include "../linkedlist_code/linked_list.hpp"
+#include "../linkedlist_code/unrolled_list.hpp"
+
+namespace {
+
+template <typename List>
+List build(int n) {
+    List list;
+    for (int i = 0; i < n; ++i) {
+        list.push_back(i);
+    }
+    return list;
+}
+
+template <typename List>
+long traverse(List& list) {
+    long sum = 0;
+    for (int value : list) {
+        sum += value;
+    }
+    return sum;
+}
+
+template <typename List>
+bool contains(List& list, int value) {
+    if constexpr (requires { list.find(value); }) {
+        return list.find(value) != list.end();
+    } else {
+        return std::find(list.begin(), list.end(), value) != list.end();
+    }
+}
+
+// Removes hit random positions, so most of the cost is the scan to them
+template <typename List>
+void mixed(List& list, int ops, unsigned seed) {
+    std::mt19937 rng(seed);
+    int next = static_cast<int>(list.size());
+    for (int i = 0; i < ops; ++i) {
+        switch (rng() % 4) {
+        case 0: list.push_back(next++); break;
+        case 1: list.push_front(next++); break;
+        case 2: list.pop_front(); list.push_back(next++); break;
+        default: list.remove(static_cast<int>(rng() % next)); break;
+        }
+    }
+}
+
+template <typename List>
+void run(const std::string& name, int n, int ops) {
+    List list = build<List>(n);
+    bench::report(name + " traverse", bench::measure(n, [&] {
+        bench::do_not_optimize(traverse(list));
+    }));
+    bench::report(name + " find (miss)", bench::measure(n, [&] {
+        bench::do_not_optimize(contains(list, -1));
+    }));
+    bench::report(name + " mixed updates", bench::measure(ops, [&] {
+        List copy = build<List>(n / 10);
+        mixed(copy, ops, 42);
+    }, 3));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1'000'000;
+    int ops = argc > 2 ? std::atoi(argv[2]) : 2'000;
+
+    run<std::list<int>>("std::list<int>", n, ops);
+    run<LinkedList<int>>("LinkedList<int>", n, ops);
+    run<UnrolledList<int, 16>>("UnrolledList<int, 16>", n, ops);
+    run<UnrolledList<int>>("UnrolledList<int, 128>", n, ops);
+    return 0;
+}
@@ -0,0 +1,128 @@
+// window_aggregates_bench.cpp
+// Live window statistics: incremental aggregators versus recomputing over
+// the buffered window (or the whole history, as calculateAverage does).
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <vector>
+#include "bench_timer.hpp"
+#include "../memory_manage/window_aggregates.hpp"
+#include "../memory_manage/data_logger.hpp"
+
+namespace {
+
+struct Max {
+    float operator()(float a, float b) const { return std::max(a, b); }
+};
+
+// Plain two-pass sum/min/max then squared deviations
+SeriesStats recompute(const std::deque<float>& window) {
+    SeriesStats s;
+    for (float v : window) {
+        s.sum += v;
+        s.min = std::min(s.min, v);
+        s.max = std::max(s.max, v);
+    }
+    s.count = window.size();
+    double mean = s.mean();
+    for (float v : window) {
+        s.m2 += (v - mean) * (v - mean);
+    }
+    return s;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int readings = argc > 1 ? std::atoi(argv[1]) : 1'000'000;
+    int window = argc > 2 ? std::atoi(argv[2]) : 3600;
+
+    std::vector<float> values(readings);
+    for (int i = 0; i < readings; ++i) {
+        values[i] = 20.0f + static_cast<float>((i * 7919) % 100) / 10.0f;
+    }
+    std::cout << readings << " readings, window of " << window << "\n";
+
+    // Update cost: one push (and one eviction) per reading
+    bench::report("SlidingWindow push (count window)", bench::measure(readings, [&] {
+        auto w = SlidingWindow::last_readings(window);
+        for (int i = 0; i < readings; ++i) {
+            w.push(i, values[i]);
+        }
+        bench::do_not_optimize(w.sum());
+    }));
+    bench::report("SlidingWindow push (time window)", bench::measure(readings, [&] {
+        auto w = SlidingWindow::last_duration(window);
+        for (int i = 0; i < readings; ++i) {
+            w.push(i, values[i]);
+        }
+        bench::do_not_optimize(w.sum());
+    }));
+    bench::report("MonotonicMinMax push+evict", bench::measure(readings, [&] {
+        MonotonicMinMax m;
+        for (int i = 0; i < readings; ++i) {
+            m.push(i, values[i]);
+            if (i >= window) {
+                m.evict_through(i - window);
+            }
+        }
+        bench::do_not_optimize(m.max());
+    }));
+    bench::report("TwoStacksWindow<max> push+pop", bench::measure(readings, [&] {
+        TwoStacksWindow<float, Max> m;
+        for (int i = 0; i < readings; ++i) {
+            m.push(values[i]);
+            if (i >= window) {
+                m.pop();
+            }
+        }
+        bench::do_not_optimize(m.query());
+    }));
+    bench::report("DataLogger::logReading with windows", bench::measure(readings, [&] {
+        DataLogger logger(WindowConfig{static_cast<size_t>(window), window, window});
+        for (int i = 0; i < readings; ++i) {
+            logger.logReading(0, values[i], i);
+        }
+        bench::do_not_optimize(logger.getWindows(0)->byCount.mean());
+    }, 3));
+
+    // Query cost: a full stats snapshot after every reading
+    int queries = std::min(readings, 100'000);
+    bench::report("push + SlidingWindow::stats()", bench::measure(queries, [&] {
+        auto w = SlidingWindow::last_readings(window);
+        double acc = 0;
+        for (int i = 0; i < queries; ++i) {
+            w.push(i, values[i]);
+            acc += w.stats().variance();
+        }
+        bench::do_not_optimize(acc);
+    }, 3));
+    bench::report("push + recompute over window deque", bench::measure(queries, [&] {
+        std::deque<float> w;
+        double acc = 0;
+        for (int i = 0; i < queries; ++i) {
+            w.push_back(values[i]);
+            if (static_cast<int>(w.size()) > window) {
+                w.pop_front();
+            }
+            acc += recompute(w).variance();
+        }
+        bench::do_not_optimize(acc);
+    }, 3));
+    int history_queries = std::min(queries, 20'000);
+    bench::report("push + recompute over full history", bench::measure(history_queries, [&] {
+        std::vector<float> history;
+        double acc = 0;
+        for (int i = 0; i < history_queries; ++i) {
+            history.push_back(values[i]);
+            float sum = 0.0f;  // DataAnalyzer::calculateAverage
+            for (float v : history) {
+                sum += v;
+            }
+            acc += sum / history.size();
+        }
+        bench::do_not_optimize(acc);
+    }, 3));
+    return 0;
+}
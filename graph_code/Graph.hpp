@@ -5,13 +5,41 @@
 #include <vector>
 #include <unordered_map>
 #include <string>
+#include <string_view>
 #include <set>
+#include <memory_resource>
 
 class Graph {
 private:
-    std::unordered_map<std::string, std::set<std::string>> connections;
+    // Let the pmr-keyed containers be searched with a plain std::string
+    struct PlaceHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view place) const noexcept {
+            return std::hash<std::string_view>{}(place);
+        }
+    };
+
+    struct PlaceEqual {
+        using is_transparent = void;
+        bool operator()(std::string_view a, std::string_view b) const noexcept {
+            return a == b;
+        }
+    };
+
+    struct PlaceLess {
+        using is_transparent = void;
+        bool operator()(std::string_view a, std::string_view b) const noexcept {
+            return a < b;
+        }
+    };
+
+    using PlaceSet = std::pmr::set<std::pmr::string, PlaceLess>;
+    std::pmr::unordered_map<std::pmr::string, PlaceSet, PlaceHash, PlaceEqual> connections;
 
 public:
+    // Every place name, neighbor set and hash node is allocated from resource
+    explicit Graph(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
     void addPlace(const std::string& place);
     void addPath(const std::string& from, const std::string& to);
     bool hasDirectPath(const std::string& from, const std::string& to) const;
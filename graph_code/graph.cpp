@@ -1,11 +1,14 @@
 // Graph.cpp
 #include "Graph.hpp"
 #include <iostream>
+#include <tuple>
+
+Graph::Graph(std::pmr::memory_resource* resource) : connections(resource) {}
 
 void Graph::addPlace(const std::string& place) {
     // If the place doesn't exist yet, add it with an empty set of connections
     if (connections.find(place) == connections.end()) {
-        connections[place] = std::set<std::string>();
+        connections.emplace(std::piecewise_construct, std::forward_as_tuple(place), std::tuple<>());
     }
 }
 
@@ -13,7 +16,7 @@ void Graph::addPath(const std::string& from, const std::string& to) {
     // Make sure both places exist in our graph
     addPlace(from);
     addPlace(to);
-    connections[from].insert(to);
+    connections.find(from)->second.emplace(to);
 }
 
 bool Graph::hasDirectPath(const std::string& from, const std::string& to) const {
@@ -34,13 +37,13 @@ std::set<std::string> Graph::getNeighbors(const std::string& place) const {
         return std::set<std::string>();
     }
 
-    return it->second;
+    return std::set<std::string>(it->second.begin(), it->second.end());
 }
 
 std::vector<std::string> Graph::getAllPlaces() const {
     std::vector<std::string> places;
     for (const auto& pair : connections) {
-        places.push_back(pair.first);
+        places.emplace_back(pair.first);
     }
     return places;
 }
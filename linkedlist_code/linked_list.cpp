@@ -34,6 +34,15 @@ int main() {
         std::cout << "Popped: " << *value << "\n";
     }
     
+    // Reorder in place: sort descending, then drop the multiples of four
+    numbers.sort(std::greater<>());
+    numbers.remove_if([](int n) { return n % 4 == 0; });
+    std::cout << "Sorted, without multiples of 4: ";
+    for (const auto& num : numbers) {
+        std::cout << num << " ";
+    }
+    std::cout << "\n";
+    
     // String list example
     LinkedList<std::string> words;
     words.push_back("Hello");
@@ -4,32 +4,115 @@
 #include <memory>
 #include <optional>
 #include <functional>
+#include <cstdint>
 #include <stdexcept>
 #include <initializer_list>
 #include <iterator>
+#include <utility>
+#include <type_traits>
+#include "node_pool.hpp"
+#include "../memory_manage/container_stats.hpp"
+#include "../memory_manage/serialization.hpp"
 
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class LinkedList {
 private:
-    struct Node {
+    struct Node;
+    
+    // The link part of a node. The list's before_head sentinel is a bare
+    // NodeBase, which lets *_after operations work at the front too.
+    struct NodeBase {
+        Node* next = nullptr;
+    };
+    
+    struct Node : NodeBase {
         T data;
-        std::unique_ptr<Node> next;
         
         // Perfect forwarding constructor
         template <typename U>
         requires std::convertible_to<U, T>
-        explicit Node(U&& value) : data(std::forward<U>(value)), next(nullptr) {}
+        explicit Node(U&& value) : data(std::forward<U>(value)) {}
     };
     
-    std::unique_ptr<Node> head;
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+    
+    NodeBase before_head;  // before_head.next is the first node
     Node* tail = nullptr;
     size_t node_count = 0;
+    // Nodes come from slabs and are recycled here instead of being freed
+    NodePool<Node, NodeAllocator> pool;
+    // Node-level accounting; slabs show up through a TrackingAllocator
+    [[no_unique_address]] mutable container_stats::InstanceStats<container_stats::Kind::linked_list> instrumentation;
+    
+    template <typename U>
+    Node* create_node(U&& value) {
+        Node* node = pool.allocate();
+        try {
+            std::construct_at(node, std::forward<U>(value));
+        } catch (...) {
+            pool.deallocate(node);
+            throw;
+        }
+        instrumentation.allocation(sizeof(Node));
+        return node;
+    }
+    
+    void destroy_node(Node* node) noexcept {
+        instrumentation.free(sizeof(Node));
+        std::destroy_at(node);
+        pool.deallocate(node);
+    }
+    
+    bool same_allocator(const LinkedList& other) const noexcept {
+        return NodeTraits::is_always_equal::value ||
+               pool.get_allocator() == other.pool.get_allocator();
+    }
+    
+    // Merge two sorted null-terminated chains; ties go to `a`
+    template <typename Compare>
+    static Node* merge_chains(Node* a, Node* b, Compare& comp) {
+        NodeBase merged;
+        NodeBase* out = &merged;
+        while (a && b) {
+            if (comp(b->data, a->data)) {
+                out->next = b;
+                b = b->next;
+            } else {
+                out->next = a;
+                a = a->next;
+            }
+            out = out->next;
+        }
+        out->next = a ? a : b;
+        return merged.next;
+    }
+    
+    void fix_tail() noexcept {
+        Node* node = before_head.next;
+        while (node && node->next) {
+            node = node->next;
+        }
+        tail = node;
+    }
+    
+    // Take over other's nodes; *this must be empty
+    void steal(LinkedList& other) noexcept {
+        instrumentation.transfer(other.instrumentation, other.node_count * sizeof(Node));
+        before_head.next = std::exchange(other.before_head.next, nullptr);
+        tail = std::exchange(other.tail, nullptr);
+        node_count = std::exchange(other.node_count, 0);
+    }
 
 public:
+    // Nodes reach the allocator only in slabs of this size
+    static constexpr size_t node_slab_bytes = NodePool<Node, NodeAllocator>::slab_bytes;
+
     // Iterator implementation
     class iterator {
     private:
-        Node* current;
+        NodeBase* current;
+        friend class LinkedList;
     public:
         using iterator_category = std::forward_iterator_tag;
         using value_type = T;
@@ -37,21 +120,21 @@ public:
         using pointer = T*;
         using reference = T&;
         
-        explicit iterator(Node* node) : current(node) {}
+        explicit iterator(NodeBase* node) : current(node) {}
         
-        reference operator*() const { return current->data; }
-        pointer operator->() const { return &(current->data); }
+        reference operator*() const { return static_cast<Node*>(current)->data; }
+        pointer operator->() const { return &(static_cast<Node*>(current)->data); }
         
         // Pre-increment
         iterator& operator++() {
-            current = current->next.get();
+            current = current->next;
             return *this;
         }
         
         // Post-increment
         iterator operator++(int) {
             iterator temp = *this;
-            current = current->next.get();
+            current = current->next;
             return temp;
         }
         
@@ -64,19 +147,31 @@ public:
         }
     };
     
+    using allocator_type = Allocator;
+    
     // Constructors
     LinkedList() = default;
     
-    LinkedList(std::initializer_list<T> init) {
+    // Allocate nodes from the given allocator (e.g. a pmr arena)
+    explicit LinkedList(const Allocator& alloc) : pool(NodeAllocator(alloc)) {}
+    
+    LinkedList(std::initializer_list<T> init, const Allocator& alloc = Allocator())
+        : pool(NodeAllocator(alloc)) {
         for (const auto& item : init) {
             push_back(item);
         }
     }
     
-    // Rule of five
-    ~LinkedList() = default;  // unique_ptr handles cleanup
+    // Rule of five. Trivially destructible elements need no walk at all:
+    // dropping the pool's slabs frees every node at once.
+    ~LinkedList() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            clear();
+        }
+    }
     
-    LinkedList(const LinkedList& other) {
+    LinkedList(const LinkedList& other)
+        : pool(NodeTraits::select_on_container_copy_construction(other.pool.get_allocator())) {
         for (const auto& item : other) {
             push_back(item);
         }
@@ -92,26 +187,57 @@ public:
         return *this;
     }
     
-    LinkedList(LinkedList&& other) noexcept = default;
-    LinkedList& operator=(LinkedList&& other) noexcept = default;
+    LinkedList(LinkedList&& other) noexcept : pool(std::move(other.pool)) {
+        steal(other);
+    }
+    
+    // Nodes can only change hands when both lists free them the same way;
+    // otherwise the elements are moved one by one.
+    LinkedList& operator=(LinkedList&& other) noexcept(
+        NodeTraits::propagate_on_container_move_assignment::value ||
+        NodeTraits::is_always_equal::value) {
+        if (this != &other) {
+            clear();
+            if constexpr (NodeTraits::propagate_on_container_move_assignment::value) {
+                pool = std::move(other.pool);
+                steal(other);
+            } else if (same_allocator(other)) {
+                pool.absorb(other.pool);
+                steal(other);
+            } else {
+                for (auto& item : other) {
+                    push_back(std::move(item));
+                }
+                other.clear();
+            }
+        }
+        return *this;
+    }
+    
+    [[nodiscard]] allocator_type get_allocator() const noexcept {
+        return allocator_type(pool.get_allocator());
+    }
     
     // Iterator functions
-    [[nodiscard]] iterator begin() const noexcept { return iterator(head.get()); }
+    [[nodiscard]] iterator begin() const noexcept { return iterator(before_head.next); }
     [[nodiscard]] iterator end() const noexcept { return iterator(nullptr); }
     
+    // Position before the first element, for insert_after/erase_after/splice_after
+    [[nodiscard]] iterator before_begin() const noexcept {
+        return iterator(const_cast<NodeBase*>(&before_head));
+    }
+    
     // Core operations
     template <typename U>
     requires std::convertible_to<U, T>
     void push_front(U&& value) {
-        auto new_node = std::make_unique<Node>(std::forward<U>(value));
+        Node* new_node = create_node(std::forward<U>(value));
         
         if (empty()) {
-            head = std::move(new_node);
-            tail = head.get();
-        } else {
-            new_node->next = std::move(head);
-            head = std::move(new_node);
+            tail = new_node;
         }
+        new_node->next = before_head.next;
+        before_head.next = new_node;
         
         ++node_count;
     }
@@ -119,15 +245,14 @@ public:
     template <typename U>
     requires std::convertible_to<U, T>
     void push_back(U&& value) {
-        auto new_node = std::make_unique<Node>(std::forward<U>(value));
+        Node* new_node = create_node(std::forward<U>(value));
         
         if (empty()) {
-            head = std::move(new_node);
-            tail = head.get();
+            before_head.next = new_node;
         } else {
-            tail->next = std::move(new_node);
-            tail = tail->next.get();
+            tail->next = new_node;
         }
+        tail = new_node;
         
         ++node_count;
     }
@@ -137,10 +262,12 @@ public:
             return std::nullopt;
         }
         
-        T value = std::move(head->data);
-        head = std::move(head->next);
+        Node* old_head = before_head.next;
+        T value = std::move(old_head->data);
+        before_head.next = old_head->next;
+        destroy_node(old_head);
         
-        if (!head) {
+        if (!before_head.next) {
             tail = nullptr;
         }
         
@@ -156,24 +283,39 @@ public:
         return node_count;
     }
     
+    // Iterative, so stack depth stays constant however long the list is.
+    // Nodes go back to the pool for reuse; see shrink_to_fit().
     void clear() noexcept {
-        head.reset();
+        Node* node = std::exchange(before_head.next, nullptr);
+        while (node) {
+            Node* next = node->next;
+            destroy_node(node);
+            node = next;
+        }
         tail = nullptr;
         node_count = 0;
     }
     
+    // Hand pooled node memory back to the allocator. Only an empty list owns
+    // no live nodes, so this does nothing otherwise.
+    void shrink_to_fit() noexcept {
+        if (empty()) {
+            pool.release();
+        }
+    }
+    
     [[nodiscard]] const T& front() const {
         if (empty()) {
             throw std::out_of_range("List is empty");
         }
-        return head->data;
+        return before_head.next->data;
     }
     
     [[nodiscard]] T& front() {
         if (empty()) {
             throw std::out_of_range("List is empty");
         }
-        return head->data;
+        return before_head.next->data;
     }
     
     [[nodiscard]] const T& back() const {
@@ -192,11 +334,15 @@ public:
     
     // Find first occurrence of value
     [[nodiscard]] iterator find(const T& value) const {
+        size_t probes = 0;
         for (auto it = begin(); it != end(); ++it) {
+            ++probes;
             if (*it == value) {
+                instrumentation.scan(probes);
                 return it;
             }
         }
+        instrumentation.scan(probes);
         return end();
     }
     
@@ -206,21 +352,27 @@ public:
             return false;
         }
         
-        if (head->data == value) {
+        if (before_head.next->data == value) {
+            instrumentation.scan(1);
             pop_front();
             return true;
         }
         
-        Node* current = head.get();
+        Node* current = before_head.next;
+        size_t probes = 1;
         while (current->next && current->next->data != value) {
-            current = current->next.get();
+            current = current->next;
+            ++probes;
         }
+        instrumentation.scan(current->next ? probes + 1 : probes);
         
         if (current->next) {
-            if (current->next.get() == tail) {
+            Node* doomed = current->next;
+            if (doomed == tail) {
                 tail = current;
             }
-            current->next = std::move(current->next->next);
+            current->next = doomed->next;
+            destroy_node(doomed);
             --node_count;
             return true;
         }
@@ -228,8 +380,199 @@ public:
         return false;
     }
     
-    // Apply function to each element
-    void for_each(const std::function<void(T&)>& func) {
+    // Insert after pos in O(1); returns an iterator to the new element
+    template <typename U>
+    requires std::convertible_to<U, T>
+    iterator insert_after(iterator pos, U&& value) {
+        Node* new_node = create_node(std::forward<U>(value));
+        new_node->next = pos.current->next;
+        pos.current->next = new_node;
+        if (!new_node->next) {
+            tail = new_node;
+        }
+        ++node_count;
+        return iterator(new_node);
+    }
+    
+    // Erase the element after pos in O(1); returns the one that followed it
+    iterator erase_after(iterator pos) {
+        Node* doomed = pos.current->next;
+        if (!doomed) {
+            return end();
+        }
+        pos.current->next = doomed->next;
+        if (doomed == tail) {
+            tail = pos.current == &before_head ? nullptr : static_cast<Node*>(pos.current);
+        }
+        destroy_node(doomed);
+        --node_count;
+        return iterator(pos.current->next);
+    }
+    
+    // Move every element of other in after pos, leaving other empty.
+    // O(1) when the allocators compare equal: the nodes are relinked and
+    // this list adopts other's node pool along with them.
+    void splice_after(iterator pos, LinkedList& other) {
+        if (&other == this || other.empty()) {
+            return;
+        }
+        if (!same_allocator(other)) {
+            for (auto& item : other) {
+                pos = insert_after(pos, std::move(item));
+            }
+            other.clear();
+            return;
+        }
+        pool.absorb(other.pool);
+        Node* after = pos.current->next;
+        pos.current->next = other.before_head.next;
+        other.tail->next = after;
+        if (!after) {
+            tail = other.tail;
+        }
+        instrumentation.transfer(other.instrumentation, other.node_count * sizeof(Node));
+        node_count += other.node_count;
+        other.before_head.next = nullptr;
+        other.tail = nullptr;
+        other.node_count = 0;
+    }
+    
+    void splice_after(iterator pos, LinkedList&& other) {
+        splice_after(pos, other);
+    }
+    
+    // Concatenate other onto the end of this list in O(1)
+    void append(LinkedList& other) {
+        splice_after(empty() ? before_begin() : iterator(tail), other);
+    }
+    
+    void append(LinkedList&& other) {
+        append(other);
+    }
+    
+    // Remove every element matching pred in a single pass; returns the count
+    template <typename Predicate>
+    size_t remove_if(Predicate pred) {
+        size_t removed = 0;
+        NodeBase* prev = &before_head;
+        while (Node* current = prev->next) {
+            if (pred(current->data)) {
+                prev->next = current->next;
+                destroy_node(current);
+                ++removed;
+            } else {
+                prev = current;
+            }
+        }
+        tail = prev == &before_head ? nullptr : static_cast<Node*>(prev);
+        node_count -= removed;
+        return removed;
+    }
+    
+    // Merge sorted other into this sorted list, leaving other empty. Stable:
+    // among equal elements, this list's come first.
+    template <typename Compare = std::less<>>
+    void merge(LinkedList& other, Compare comp = Compare()) {
+        if (&other == this || other.empty()) {
+            return;
+        }
+        if (!same_allocator(other)) {
+            LinkedList adopted(get_allocator());
+            for (auto& item : other) {
+                adopted.push_back(std::move(item));
+            }
+            other.clear();
+            merge(adopted, comp);
+            return;
+        }
+        pool.absorb(other.pool);
+        // Ties go to this list, so other's tail ends up last unless it is smaller
+        if (empty() || !comp(other.tail->data, tail->data)) {
+            tail = other.tail;
+        }
+        before_head.next = merge_chains(before_head.next, other.before_head.next, comp);
+        instrumentation.transfer(other.instrumentation, other.node_count * sizeof(Node));
+        node_count += other.node_count;
+        other.before_head.next = nullptr;
+        other.tail = nullptr;
+        other.node_count = 0;
+    }
+    
+    template <typename Compare = std::less<>>
+    void merge(LinkedList&& other, Compare comp = Compare()) {
+        merge(other, comp);
+    }
+    
+    // Stable bottom-up merge sort. Only relinks nodes: no allocation, no
+    // element moves, and O(log n) fixed stack space for the run bins.
+    template <typename Compare = std::less<>>
+    void sort(Compare comp = Compare()) {
+        if (node_count < 2) {
+            return;
+        }
+        // bins[i] holds a sorted run of 2^i nodes that precede any run in a
+        // lower bin, so merging a bin before the carried run keeps stability
+        Node* bins[64] = {};
+        int filled = 0;
+        Node* rest = before_head.next;
+        while (rest) {
+            Node* carry = rest;
+            rest = rest->next;
+            carry->next = nullptr;
+            int i = 0;
+            for (; i < filled && bins[i]; ++i) {
+                carry = merge_chains(bins[i], carry, comp);
+                bins[i] = nullptr;
+            }
+            bins[i] = carry;
+            if (i == filled) {
+                ++filled;
+            }
+        }
+        Node* sorted = nullptr;
+        for (int i = 0; i < filled; ++i) {
+            if (bins[i]) {
+                sorted = merge_chains(bins[i], sorted, comp);
+            }
+        }
+        before_head.next = sorted;
+        fix_tail();
+    }
+    
+    // Node allocations and frees, live and peak node bytes, and find/remove
+    // scan lengths; all zero unless built with CONTAINER_STATS
+    [[nodiscard]] const container_stats::Counters& stats() const noexcept {
+        return instrumentation.counters();
+    }
+    
+    // Binary form: frame, then the elements front to back (see
+    // serialization.hpp). deserialize replaces the contents and leaves them
+    // untouched if the input is bad
+    void serialize(serialization::Encoder& out) const {
+        serialization::write_header(out, serialization::ContainerKind::linked_list, serialization::layout_tag<T>,
+                                    node_count);
+        for (const auto& item : *this) {
+            out.write(item);
+        }
+    }
+
+    void deserialize(serialization::Decoder& in) {
+        std::uint64_t count =
+            serialization::read_header(in, serialization::ContainerKind::linked_list, serialization::layout_tag<T>);
+        LinkedList incoming(get_allocator());
+        for (; count > 0; --count) {
+            T item{};
+            in.read(item);
+            incoming.push_back(std::move(item));
+        }
+        *this = std::move(incoming);
+    }
+
+    // Apply function to each element. Taking the callable as a template
+    // parameter lets the compiler inline it; see list_algorithms.hpp for
+    // the policy-based (parallel) versions.
+    template <typename Func>
+    void for_each(Func&& func) {
         for (auto it = begin(); it != end(); ++it) {
             func(*it);
         }
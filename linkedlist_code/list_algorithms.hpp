@@ -0,0 +1,220 @@
+#ifndef LIST_ALGORITHMS_HPP
+#define LIST_ALGORITHMS_HPP
+
+#include <vector>
+#include <thread>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include <concepts>
+#include <utility>
+#include <cstddef>
+#include "linked_list.hpp"
+
+// for_each / transform / reduce over a LinkedList with an execution policy.
+// The callable is a template parameter, so simple lambdas inline completely.
+//
+//     for_each(list_exec::par, numbers, [](int& n) { n *= 2; });
+//     long total = reduce(list_exec::par, numbers, 0L, std::plus<>());
+//
+// The parallel policy splits the list into contiguous chunks, one per
+// thread, using a ListChunkIndex. Building the index costs one walk of the
+// list, so callers that run several passes over an unchanged list should
+// build it once and pass it in.
+namespace list_exec {
+
+struct sequenced_policy {};
+
+struct parallel_policy {
+    unsigned threads = 0;  // 0 = std::thread::hardware_concurrency()
+
+    [[nodiscard]] constexpr parallel_policy with_threads(unsigned count) const noexcept {
+        return parallel_policy{count};
+    }
+};
+
+inline constexpr sequenced_policy seq{};
+inline constexpr parallel_policy par{};
+
+// Below this many elements per chunk the thread start-up costs more than it saves
+inline constexpr size_t min_chunk_elements = 16384;
+
+inline size_t chunk_count(const parallel_policy& policy, size_t elements) noexcept {
+    size_t threads = policy.threads ? policy.threads : std::thread::hardware_concurrency();
+    size_t by_grain = std::max<size_t>(1, elements / min_chunk_elements);
+    return std::max<size_t>(1, std::min(threads, by_grain));
+}
+
+} // namespace list_exec
+
+// Start positions and lengths of equal-sized runs of a list. Stays valid
+// until an element is inserted or removed; element values may change.
+template <typename T, typename Allocator>
+class ListChunkIndex {
+public:
+    using iterator = typename LinkedList<T, Allocator>::iterator;
+
+    ListChunkIndex(const LinkedList<T, Allocator>& list, size_t chunks) : indexed_size(list.size()) {
+        size_t count = std::max<size_t>(1, std::min(chunks, indexed_size));
+        size_t base = indexed_size / count;
+        size_t extra = indexed_size % count;
+        auto it = list.begin();
+        for (size_t c = 0; c < count && it != list.end(); ++c) {
+            size_t length = base + (c < extra ? 1 : 0);
+            starts.push_back(it);
+            lengths.push_back(length);
+            std::advance(it, length);
+        }
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return starts.size(); }
+    [[nodiscard]] iterator chunk_begin(size_t chunk) const { return starts[chunk]; }
+    [[nodiscard]] size_t chunk_length(size_t chunk) const { return lengths[chunk]; }
+    [[nodiscard]] size_t list_size() const noexcept { return indexed_size; }
+
+private:
+    std::vector<iterator> starts;
+    std::vector<size_t> lengths;
+    size_t indexed_size;
+};
+
+namespace list_exec_detail {
+
+// Runs body(chunk) for every chunk, chunk 0 on the calling thread.
+// The first exception thrown by any chunk is rethrown after all have joined.
+template <typename Body>
+void run_chunks(size_t chunks, Body& body) {
+    if (chunks == 0) {
+        return;
+    }
+    std::vector<std::exception_ptr> errors(chunks);
+    std::vector<std::thread> workers;
+    workers.reserve(chunks - 1);
+    auto guarded = [&](size_t chunk) {
+        try {
+            body(chunk);
+        } catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    };
+    for (size_t c = 1; c < chunks; ++c) {
+        workers.emplace_back(guarded, c);
+    }
+    guarded(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+template <typename T, typename Allocator>
+void check_index(const LinkedList<T, Allocator>& list, const ListChunkIndex<T, Allocator>& index) {
+    if (index.list_size() != list.size()) {
+        throw std::invalid_argument("ListChunkIndex is stale: the list changed size");
+    }
+}
+
+} // namespace list_exec_detail
+
+// Apply func to each element
+template <typename T, typename Allocator, typename Func>
+void for_each(list_exec::sequenced_policy, LinkedList<T, Allocator>& list, Func func) {
+    for (auto& item : list) {
+        func(item);
+    }
+}
+
+template <typename T, typename Allocator, typename Func>
+void for_each(list_exec::parallel_policy, LinkedList<T, Allocator>& list,
+              const ListChunkIndex<T, Allocator>& index, Func func) {
+    list_exec_detail::check_index(list, index);
+    auto body = [&](size_t chunk) {
+        auto it = index.chunk_begin(chunk);
+        for (size_t i = index.chunk_length(chunk); i > 0; --i, ++it) {
+            func(*it);
+        }
+    };
+    list_exec_detail::run_chunks(index.size(), body);
+}
+
+template <typename T, typename Allocator, typename Func>
+void for_each(list_exec::parallel_policy policy, LinkedList<T, Allocator>& list, Func func) {
+    ListChunkIndex<T, Allocator> index(list, list_exec::chunk_count(policy, list.size()));
+    for_each(policy, list, index, std::move(func));
+}
+
+// Replace each element with op(element), in place
+template <typename T, typename Allocator, typename UnaryOp>
+void transform(list_exec::sequenced_policy, LinkedList<T, Allocator>& list, UnaryOp op) {
+    for (auto& item : list) {
+        item = op(std::as_const(item));
+    }
+}
+
+template <typename T, typename Allocator, typename UnaryOp>
+void transform(list_exec::parallel_policy policy, LinkedList<T, Allocator>& list,
+               const ListChunkIndex<T, Allocator>& index, UnaryOp op) {
+    for_each(policy, list, index, [&op](T& item) { item = op(std::as_const(item)); });
+}
+
+template <typename T, typename Allocator, typename UnaryOp>
+void transform(list_exec::parallel_policy policy, LinkedList<T, Allocator>& list, UnaryOp op) {
+    ListChunkIndex<T, Allocator> index(list, list_exec::chunk_count(policy, list.size()));
+    transform(policy, list, index, std::move(op));
+}
+
+// Fold the elements with op starting from init. As with std::reduce, the
+// parallel version regroups terms, so op should be associative and
+// commutative, and it starts each chunk from that chunk's first element
+// converted to Result: op(acc, x) must equal op(acc, Result(x)), and op
+// must also combine two partial results. Folds that treat an element
+// differently from a partial result, such as counting with
+// [](long n, const T&) { return n + 1; }, need the sequenced version.
+template <typename T, typename Allocator, typename Result, typename BinaryOp = std::plus<>>
+Result reduce(list_exec::sequenced_policy, const LinkedList<T, Allocator>& list,
+              Result init, BinaryOp op = BinaryOp()) {
+    for (const auto& item : list) {
+        init = op(std::move(init), item);
+    }
+    return init;
+}
+
+template <typename T, typename Allocator, typename Result, typename BinaryOp = std::plus<>>
+requires std::convertible_to<const T&, Result> && std::invocable<BinaryOp&, Result, Result>
+Result reduce(list_exec::parallel_policy, const LinkedList<T, Allocator>& list,
+              const ListChunkIndex<T, Allocator>& index, Result init, BinaryOp op = BinaryOp()) {
+    list_exec_detail::check_index(list, index);
+    // Each chunk folds from its own first element, so init is applied once
+    std::vector<Result> partials(index.size());
+    auto body = [&](size_t chunk) {
+        auto it = index.chunk_begin(chunk);
+        Result acc = static_cast<Result>(*it);
+        for (size_t i = index.chunk_length(chunk) - 1; i > 0; --i) {
+            acc = op(std::move(acc), *++it);
+        }
+        partials[chunk] = std::move(acc);
+    };
+    if (index.list_size() == 0) {
+        return init;
+    }
+    list_exec_detail::run_chunks(index.size(), body);
+    for (auto& partial : partials) {
+        init = op(std::move(init), std::move(partial));
+    }
+    return init;
+}
+
+template <typename T, typename Allocator, typename Result, typename BinaryOp = std::plus<>>
+requires std::convertible_to<const T&, Result> && std::invocable<BinaryOp&, Result, Result>
+Result reduce(list_exec::parallel_policy policy, const LinkedList<T, Allocator>& list,
+              Result init, BinaryOp op = BinaryOp()) {
+    ListChunkIndex<T, Allocator> index(list, list_exec::chunk_count(policy, list.size()));
+    return reduce(policy, list, index, std::move(init), std::move(op));
+}
+
+#endif // LIST_ALGORITHMS_HPP
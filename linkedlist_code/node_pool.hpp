@@ -0,0 +1,154 @@
+#ifndef NODE_POOL_HPP
+#define NODE_POOL_HPP
+
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+
+// Slab-backed free-list that hands out raw storage for one Node at a time.
+// Storage is carved from slabs obtained through Allocator and recycled
+// through an intrusive free-list, so steady-state churn never reaches malloc.
+// Slabs are only returned to the allocator by release() or the destructor.
+template <typename Node, typename Allocator = std::allocator<Node>>
+class NodePool {
+private:
+    union Block {
+        Block* next;
+        alignas(Node) std::byte storage[sizeof(Node)];
+    };
+
+    using BlockAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Block>;
+    using BlockTraits = std::allocator_traits<BlockAllocator>;
+
+    // About 16 KiB per slab; the first block of each slab links the slabs
+    static constexpr size_t blocks_per_slab = std::max<size_t>(32, 16384 / sizeof(Block));
+
+public:
+    // Bytes in each request to the allocator
+    static constexpr size_t slab_bytes = blocks_per_slab * sizeof(Block);
+
+    explicit NodePool(const Allocator& alloc = Allocator()) : block_alloc(alloc) {}
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    NodePool(NodePool&& other) noexcept : block_alloc(std::move(other.block_alloc)) {
+        steal(other);
+    }
+
+    // Drops this pool's slabs; only valid when none of its storage is in use
+    NodePool& operator=(NodePool&& other) noexcept {
+        if (this != &other) {
+            release();
+            block_alloc = std::move(other.block_alloc);
+            steal(other);
+        }
+        return *this;
+    }
+
+    ~NodePool() {
+        release();
+    }
+
+    [[nodiscard]] Node* allocate() {
+        if (free_head) {
+            Block* block = free_head;
+            free_head = block->next;
+            return reinterpret_cast<Node*>(block->storage);
+        }
+        if (carve == carve_end) {
+            add_slab();
+        }
+        return reinterpret_cast<Node*>((carve++)->storage);
+    }
+
+    void deallocate(Node* node) noexcept {
+        Block* block = reinterpret_cast<Block*>(node);
+        block->next = free_head;
+        if (!free_head) {
+            free_tail = block;
+        }
+        free_head = block;
+    }
+
+    // Takes over other's slabs and free storage in O(1), so nodes handed out
+    // by other may from now on be returned to this pool. The allocators must
+    // compare equal.
+    void absorb(NodePool& other) noexcept {
+        if (this == &other || !other.slab_head) {
+            return;
+        }
+        other.slab_tail->next = slab_head;
+        slab_head = other.slab_head;
+        if (!slab_tail) {
+            slab_tail = other.slab_tail;
+        }
+        if (other.free_head) {
+            other.free_tail->next = free_head;
+            if (!free_head) {
+                free_tail = other.free_tail;
+            }
+            free_head = other.free_head;
+        }
+        if (carve == carve_end) {
+            carve = other.carve;
+            carve_end = other.carve_end;
+        }
+        other.reset();
+    }
+
+    // Returns every slab to the allocator; all storage handed out is invalid
+    void release() noexcept {
+        while (slab_head) {
+            Block* next = slab_head->next;
+            BlockTraits::deallocate(block_alloc, slab_head, blocks_per_slab);
+            slab_head = next;
+        }
+        reset();
+    }
+
+    [[nodiscard]] Allocator get_allocator() const noexcept {
+        return Allocator(block_alloc);
+    }
+
+private:
+    void add_slab() {
+        Block* slab = BlockTraits::allocate(block_alloc, blocks_per_slab);
+        slab->next = nullptr;
+        if (slab_tail) {
+            slab_tail->next = slab;
+        } else {
+            slab_head = slab;
+        }
+        slab_tail = slab;
+        carve = slab + 1;
+        carve_end = slab + blocks_per_slab;
+    }
+
+    void steal(NodePool& other) noexcept {
+        slab_head = other.slab_head;
+        slab_tail = other.slab_tail;
+        free_head = other.free_head;
+        free_tail = other.free_tail;
+        carve = other.carve;
+        carve_end = other.carve_end;
+        other.reset();
+    }
+
+    void reset() noexcept {
+        slab_head = slab_tail = nullptr;
+        free_head = free_tail = nullptr;
+        carve = carve_end = nullptr;
+    }
+
+    [[no_unique_address]] BlockAllocator block_alloc;
+    Block* slab_head = nullptr;
+    Block* slab_tail = nullptr;
+    Block* free_head = nullptr;
+    Block* free_tail = nullptr;
+    Block* carve = nullptr;
+    Block* carve_end = nullptr;
+};
+
+#endif // NODE_POOL_HPP
@@ -0,0 +1,322 @@
+#ifndef SKIP_LIST_HPP
+#define SKIP_LIST_HPP
+
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <new>
+#include <iterator>
+#include <functional>
+#include <stdexcept>
+#include <algorithm>
+#include <concepts>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+
+// Ordered set with lock-free concurrent insert and wait-free lookups.
+//
+// Each node is a LinkedList-style node with a whole tower of next pointers:
+// level 0 links every key in order, and each higher level skips over
+// roughly 1/p as many nodes as the level below. Inserts link a new node
+// bottom-up with one compare-exchange per level and retry locally when
+// they lose a race. Keys are never removed, so readers can follow any
+// pointer they load without reclamation concerns (the same trade-off as a
+// LevelDB memtable).
+//
+// Towers are carved from an internal arena of large blocks that is freed
+// when the list is destroyed.
+template <typename Key, typename Compare = std::less<Key>>
+class ConcurrentSkipList {
+public:
+    static constexpr int max_height = 32;
+
+private:
+    struct alignas(std::atomic<void*>) Node {
+        Key key;
+        int height;
+
+        template <typename K>
+        Node(K&& k, int h) : key(std::forward<K>(k)), height(h) {}
+
+        // The tower of next pointers is laid out right after the node
+        std::atomic<Node*>* links() noexcept {
+            return reinterpret_cast<std::atomic<Node*>*>(this + 1);
+        }
+    };
+
+    // Bump allocator shared by all inserting threads. The fast path is a
+    // single fetch_add; a mutex is taken only to chain in a fresh block.
+    class Arena {
+    public:
+        Arena() = default;
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        ~Arena() {
+            Block* block = current.load(std::memory_order_relaxed);
+            while (block) {
+                Block* prev = block->prev;
+                ::operator delete(block, std::align_val_t{alignof(Block)});
+                block = prev;
+            }
+        }
+
+        void* allocate(size_t bytes) {
+            bytes = (bytes + alignof(Node) - 1) & ~(alignof(Node) - 1);
+            for (;;) {
+                Block* block = current.load(std::memory_order_acquire);
+                if (block) {
+                    size_t offset = block->used.fetch_add(bytes, std::memory_order_relaxed);
+                    if (offset + bytes <= block->capacity) {
+                        return block->data() + offset;
+                    }
+                }
+                grow(block, bytes);
+            }
+        }
+
+        [[nodiscard]] size_t bytes_reserved() const noexcept {
+            return reserved.load(std::memory_order_relaxed);
+        }
+
+    private:
+        struct alignas(std::max_align_t) Block {
+            Block* prev;
+            size_t capacity;
+            std::atomic<size_t> used{0};
+
+            std::byte* data() noexcept { return reinterpret_cast<std::byte*>(this + 1); }
+        };
+
+        static constexpr size_t block_bytes = 1 << 20;
+
+        void grow(Block* seen, size_t bytes) {
+            std::lock_guard<std::mutex> lock(grow_mutex);
+            if (current.load(std::memory_order_relaxed) != seen) {
+                return;  // another thread already installed a new block
+            }
+            size_t capacity = std::max(block_bytes, bytes);
+            void* raw = ::operator new(sizeof(Block) + capacity, std::align_val_t{alignof(Block)});
+            Block* block = new (raw) Block;
+            block->prev = seen;
+            block->capacity = capacity;
+            reserved.fetch_add(sizeof(Block) + capacity, std::memory_order_relaxed);
+            current.store(block, std::memory_order_release);
+        }
+
+        std::atomic<Block*> current{nullptr};
+        std::atomic<size_t> reserved{0};
+        std::mutex grow_mutex;
+    };
+
+public:
+    class iterator {
+    private:
+        Node* current;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Key;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Key*;
+        using reference = const Key&;
+
+        explicit iterator(Node* node) : current(node) {}
+
+        reference operator*() const { return current->key; }
+        pointer operator->() const { return &current->key; }
+
+        // Pre-increment
+        iterator& operator++() {
+            current = current->links()[0].load(std::memory_order_acquire);
+            return *this;
+        }
+
+        // Post-increment
+        iterator operator++(int) {
+            iterator temp = *this;
+            ++*this;
+            return temp;
+        }
+
+        bool operator==(const iterator& other) const {
+            return current == other.current;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return current != other.current;
+        }
+    };
+
+    // p is the probability that a tower reaching level i also reaches i + 1
+    explicit ConcurrentSkipList(double p = 0.25, Compare comp = Compare()) : less(std::move(comp)) {
+        if (!(p > 0.0 && p < 1.0)) {
+            throw std::invalid_argument("skip list level probability must be in (0, 1)");
+        }
+        promote_threshold = static_cast<std::uint32_t>(p * 4294967296.0);
+    }
+
+    ConcurrentSkipList(const ConcurrentSkipList&) = delete;
+    ConcurrentSkipList& operator=(const ConcurrentSkipList&) = delete;
+
+    ~ConcurrentSkipList() {
+        if constexpr (!std::is_trivially_destructible_v<Key>) {
+            Node* node = head[0].load(std::memory_order_relaxed);
+            while (node) {
+                Node* next = node->links()[0].load(std::memory_order_relaxed);
+                std::destroy_at(node);
+                node = next;
+            }
+        }
+    }
+
+    // Returns false if an equal key is already present
+    template <typename K>
+    requires std::convertible_to<K, Key>
+    bool insert(K&& key) {
+        int node_height = random_height();
+        std::atomic<Node*>* preds[max_height];
+        Node* succs[max_height];
+        if (find_position(key, node_height, preds, succs)) {
+            return false;
+        }
+
+        void* raw = arena.allocate(sizeof(Node) + node_height * sizeof(std::atomic<Node*>));
+        Node* node = new (raw) Node(std::forward<K>(key), node_height);
+        for (int level = 0; level < node_height; ++level) {
+            new (node->links() + level) std::atomic<Node*>(nullptr);
+        }
+        raise_height(node_height);
+
+        for (int level = 0; level < node_height; ++level) {
+            for (;;) {
+                node->links()[level].store(succs[level], std::memory_order_relaxed);
+                if (preds[level][level].compare_exchange_strong(succs[level], node,
+                                                                std::memory_order_release,
+                                                                std::memory_order_acquire)) {
+                    break;
+                }
+                // Lost a race: move forward from the same predecessor
+                advance(node->key, level, preds[level], succs[level]);
+                if (level == 0 && succs[0] && !less(node->key, succs[0]->key)) {
+                    // An equal key won the race; the arena keeps the bytes
+                    std::destroy_at(node);
+                    return false;
+                }
+            }
+        }
+        count.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    [[nodiscard]] bool contains(const Key& key) const {
+        return find(key) != end();
+    }
+
+    [[nodiscard]] iterator find(const Key& key) const {
+        iterator it = lower_bound(key);
+        return it != end() && !less(key, *it) ? it : end();
+    }
+
+    // First key that is not less than key
+    [[nodiscard]] iterator lower_bound(const Key& key) const {
+        std::atomic<Node*>* links = const_cast<std::atomic<Node*>*>(head);
+        Node* next = nullptr;
+        for (int level = height.load(std::memory_order_acquire) - 1; level >= 0; --level) {
+            next = links[level].load(std::memory_order_acquire);
+            while (next && less(next->key, key)) {
+                links = next->links();
+                next = links[level].load(std::memory_order_acquire);
+            }
+        }
+        return iterator(next);
+    }
+
+    [[nodiscard]] iterator begin() const noexcept {
+        return iterator(head[0].load(std::memory_order_acquire));
+    }
+
+    [[nodiscard]] iterator end() const noexcept {
+        return iterator(nullptr);
+    }
+
+    // Calls func on every key in [low, high) in ascending order
+    template <typename Func>
+    void for_each_in_range(const Key& low, const Key& high, Func&& func) const {
+        for (auto it = lower_bound(low); it != end() && less(*it, high); ++it) {
+            func(*it);
+        }
+    }
+
+    // Exact once inserts have quiesced; a lower bound while they run
+    [[nodiscard]] size_t size() const noexcept {
+        return count.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    [[nodiscard]] size_t memory_usage() const noexcept {
+        return arena.bytes_reserved();
+    }
+
+private:
+    // Fills the predecessor links and successor on every level below
+    // min_levels or the current list height. Returns true if key is present.
+    bool find_position(const Key& key, int min_levels, std::atomic<Node*>** preds, Node** succs) const {
+        std::atomic<Node*>* links = const_cast<std::atomic<Node*>*>(head);
+        int top = std::max(min_levels, height.load(std::memory_order_acquire));
+        for (int level = top - 1; level >= 0; --level) {
+            Node* next = links[level].load(std::memory_order_acquire);
+            while (next && less(next->key, key)) {
+                links = next->links();
+                next = links[level].load(std::memory_order_acquire);
+            }
+            preds[level] = links;
+            succs[level] = next;
+        }
+        return succs[0] && !less(key, succs[0]->key);
+    }
+
+    void advance(const Key& key, int level, std::atomic<Node*>*& pred, Node*& succ) const {
+        succ = pred[level].load(std::memory_order_acquire);
+        while (succ && less(succ->key, key)) {
+            pred = succ->links();
+            succ = pred[level].load(std::memory_order_acquire);
+        }
+    }
+
+    int random_height() noexcept {
+        // xorshift64* per thread; only the distribution matters here
+        thread_local std::uint64_t state =
+            0x9E3779B97F4A7C15ull ^ reinterpret_cast<std::uintptr_t>(&state);
+        int h = 1;
+        for (;;) {
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            auto draw = static_cast<std::uint32_t>((state * 0x2545F4914F6CDD1Dull) >> 32);
+            if (h == max_height || draw >= promote_threshold) {
+                return h;
+            }
+            ++h;
+        }
+    }
+
+    void raise_height(int h) noexcept {
+        int seen = height.load(std::memory_order_relaxed);
+        while (seen < h && !height.compare_exchange_weak(seen, h, std::memory_order_release,
+                                                         std::memory_order_relaxed)) {
+        }
+    }
+
+    std::atomic<Node*> head[max_height] = {};
+    std::atomic<int> height{1};
+    std::atomic<size_t> count{0};
+    std::uint32_t promote_threshold;
+    [[no_unique_address]] Compare less;
+    Arena arena;
+};
+
+#endif // SKIP_LIST_HPP
@@ -0,0 +1,474 @@
+#ifndef UNROLLED_LIST_HPP
+#define UNROLLED_LIST_HPP
+
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <cstdint>
+#include "node_pool.hpp"
+
+// Unrolled linked list: every node (chunk) stores up to K elements in a
+// contiguous array, so a scan touches one cache line per several elements
+// instead of one per element. Same interface as LinkedList.
+//
+// Each chunk keeps its elements in [begin, end) of its slot array, so
+// push_front and pop_front are O(1) just like push_back. insert() splits a
+// full chunk in half; remove() merges a chunk that drops below half full
+// with its successor, or borrows elements from it.
+//
+// Elements are relocated between slots with their move constructor, which
+// must not throw. Any insert or remove may invalidate iterators.
+template <typename T,
+          size_t K = std::max<size_t>(8, 512 / sizeof(T)),
+          typename Allocator = std::allocator<T>>
+requires (K >= 2 && K <= UINT32_MAX && std::is_nothrow_move_constructible_v<T>)
+class UnrolledList {
+private:
+    struct Chunk {
+        Chunk* next = nullptr;
+        std::uint32_t begin = 0;
+        std::uint32_t end = 0;
+        alignas(T) std::byte storage[K * sizeof(T)];
+
+        T* items() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+        std::uint32_t count() const noexcept { return end - begin; }
+    };
+
+    using ChunkAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Chunk>;
+    using ChunkTraits = std::allocator_traits<ChunkAllocator>;
+
+    Chunk* head = nullptr;
+    Chunk* tail = nullptr;
+    size_t element_count = 0;
+    NodePool<Chunk, ChunkAllocator> pool;
+
+    // Elements of a fresh chunk start at `start`, e.g. K when filled from the front
+    Chunk* create_chunk(std::uint32_t start) {
+        // Default-initialized: sets next/begin/end, leaves storage alone
+        Chunk* chunk = ::new (pool.allocate()) Chunk;
+        chunk->begin = chunk->end = start;
+        return chunk;
+    }
+
+    void destroy_chunk(Chunk* chunk) noexcept {
+        std::destroy_n(chunk->items() + chunk->begin, chunk->count());
+        std::destroy_at(chunk);
+        pool.deallocate(chunk);
+    }
+
+    static void relocate(T* from, T* to) noexcept {
+        std::construct_at(to, std::move(*from));
+        std::destroy_at(from);
+    }
+
+    // Moves a chunk's elements down to slot 0. Going front to back, every
+    // destination slot is either unused or was vacated by an earlier move.
+    static void compact(Chunk* chunk) noexcept {
+        if (chunk->begin == 0) {
+            return;
+        }
+        T* items = chunk->items();
+        std::uint32_t n = chunk->count();
+        for (std::uint32_t i = 0; i < n; ++i) {
+            relocate(items + chunk->begin + i, items + i);
+        }
+        chunk->begin = 0;
+        chunk->end = n;
+    }
+
+    void unlink(Chunk* chunk, Chunk* prev) noexcept {
+        if (prev) {
+            prev->next = chunk->next;
+        } else {
+            head = chunk->next;
+        }
+        if (chunk == tail) {
+            tail = prev;
+        }
+        destroy_chunk(chunk);
+    }
+
+    // Keep chunks at least half full after a removal: merge with the next
+    // chunk when both fit into one, otherwise borrow from it.
+    void rebalance(Chunk* chunk, Chunk* prev) noexcept {
+        if (chunk->count() == 0) {
+            unlink(chunk, prev);
+            return;
+        }
+        Chunk* next = chunk->next;
+        if (chunk->count() >= K / 2 || !next) {
+            return;
+        }
+        compact(chunk);
+        T* to = chunk->items();
+        T* from = next->items();
+        if (chunk->count() + next->count() <= K) {
+            for (std::uint32_t i = next->begin; i < next->end; ++i) {
+                relocate(from + i, to + chunk->end++);
+            }
+            next->begin = next->end;
+            unlink(next, chunk);
+        } else {
+            while (chunk->count() < K / 2) {
+                relocate(from + next->begin++, to + chunk->end++);
+            }
+        }
+    }
+
+    // Take over other's chunks; *this must be empty
+    void steal(UnrolledList& other) noexcept {
+        head = std::exchange(other.head, nullptr);
+        tail = std::exchange(other.tail, nullptr);
+        element_count = std::exchange(other.element_count, 0);
+    }
+
+public:
+    // Iterator implementation
+    class iterator {
+    private:
+        Chunk* chunk;
+        std::uint32_t index;
+        friend class UnrolledList;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator(Chunk* chunk, std::uint32_t index) : chunk(chunk), index(index) {}
+
+        reference operator*() const { return chunk->items()[index]; }
+        pointer operator->() const { return chunk->items() + index; }
+
+        // Pre-increment
+        iterator& operator++() {
+            if (++index == chunk->end) {
+                chunk = chunk->next;
+                index = chunk ? chunk->begin : 0;
+            }
+            return *this;
+        }
+
+        // Post-increment
+        iterator operator++(int) {
+            iterator temp = *this;
+            ++*this;
+            return temp;
+        }
+
+        bool operator==(const iterator& other) const {
+            return chunk == other.chunk && index == other.index;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    using allocator_type = Allocator;
+    static constexpr size_t chunk_capacity = K;
+
+    // Constructors
+    UnrolledList() = default;
+
+    explicit UnrolledList(const Allocator& alloc) : pool(ChunkAllocator(alloc)) {}
+
+    UnrolledList(std::initializer_list<T> init, const Allocator& alloc = Allocator())
+        : pool(ChunkAllocator(alloc)) {
+        for (const auto& item : init) {
+            push_back(item);
+        }
+    }
+
+    // Rule of five
+    ~UnrolledList() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            clear();
+        }
+    }
+
+    UnrolledList(const UnrolledList& other)
+        : pool(ChunkTraits::select_on_container_copy_construction(other.pool.get_allocator())) {
+        for (const auto& item : other) {
+            push_back(item);
+        }
+    }
+
+    UnrolledList& operator=(const UnrolledList& other) {
+        if (this != &other) {
+            clear();
+            for (const auto& item : other) {
+                push_back(item);
+            }
+        }
+        return *this;
+    }
+
+    UnrolledList(UnrolledList&& other) noexcept : pool(std::move(other.pool)) {
+        steal(other);
+    }
+
+    UnrolledList& operator=(UnrolledList&& other) noexcept(
+        ChunkTraits::propagate_on_container_move_assignment::value ||
+        ChunkTraits::is_always_equal::value) {
+        if (this != &other) {
+            clear();
+            if constexpr (ChunkTraits::propagate_on_container_move_assignment::value) {
+                pool = std::move(other.pool);
+                steal(other);
+            } else if (ChunkTraits::is_always_equal::value ||
+                       pool.get_allocator() == other.pool.get_allocator()) {
+                pool.absorb(other.pool);
+                steal(other);
+            } else {
+                for (auto& item : other) {
+                    push_back(std::move(item));
+                }
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept {
+        return allocator_type(pool.get_allocator());
+    }
+
+    // Iterator functions
+    [[nodiscard]] iterator begin() const noexcept {
+        return head ? iterator(head, head->begin) : end();
+    }
+    [[nodiscard]] iterator end() const noexcept { return iterator(nullptr, 0); }
+
+    // Core operations
+    template <typename U>
+    requires std::convertible_to<U, T>
+    void push_front(U&& value) {
+        if (!head || head->begin == 0) {
+            Chunk* chunk = create_chunk(K);
+            try {
+                std::construct_at(chunk->items() + K - 1, std::forward<U>(value));
+            } catch (...) {
+                destroy_chunk(chunk);
+                throw;
+            }
+            chunk->begin = K - 1;
+            chunk->next = head;
+            head = chunk;
+            if (!tail) {
+                tail = chunk;
+            }
+        } else {
+            std::construct_at(head->items() + head->begin - 1, std::forward<U>(value));
+            --head->begin;
+        }
+        ++element_count;
+    }
+
+    template <typename U>
+    requires std::convertible_to<U, T>
+    void push_back(U&& value) {
+        if (!tail || tail->end == K) {
+            Chunk* chunk = create_chunk(0);
+            try {
+                std::construct_at(chunk->items(), std::forward<U>(value));
+            } catch (...) {
+                destroy_chunk(chunk);
+                throw;
+            }
+            chunk->end = 1;
+            if (tail) {
+                tail->next = chunk;
+            } else {
+                head = chunk;
+            }
+            tail = chunk;
+        } else {
+            std::construct_at(tail->items() + tail->end, std::forward<U>(value));
+            ++tail->end;
+        }
+        ++element_count;
+    }
+
+    // Inserts before pos and returns an iterator to the new element.
+    // A full chunk is split in half first.
+    template <typename U>
+    requires std::convertible_to<U, T>
+    iterator insert(iterator pos, U&& value) {
+        if (pos == end()) {
+            push_back(std::forward<U>(value));
+            return iterator(tail, tail->end - 1);
+        }
+        T item(std::forward<U>(value));
+        Chunk* chunk = pos.chunk;
+        std::uint32_t index = pos.index;
+
+        if (chunk->count() == K) {
+            Chunk* upper = create_chunk(0);
+            std::uint32_t mid = chunk->begin + K / 2;
+            for (std::uint32_t i = mid; i < chunk->end; ++i) {
+                relocate(chunk->items() + i, upper->items() + upper->end++);
+            }
+            chunk->end = mid;
+            upper->next = chunk->next;
+            chunk->next = upper;
+            if (chunk == tail) {
+                tail = upper;
+            }
+            if (index >= mid) {
+                index -= mid;
+                chunk = upper;
+            }
+        }
+
+        T* items = chunk->items();
+        if (chunk->end < K) {
+            for (std::uint32_t i = chunk->end; i > index; --i) {
+                relocate(items + i - 1, items + i);
+            }
+            ++chunk->end;
+        } else {
+            for (std::uint32_t i = chunk->begin; i < index; ++i) {
+                relocate(items + i, items + i - 1);
+            }
+            --chunk->begin;
+            --index;
+        }
+        std::construct_at(items + index, std::move(item));
+        ++element_count;
+        return iterator(chunk, index);
+    }
+
+    std::optional<T> pop_front() {
+        if (empty()) {
+            return std::nullopt;
+        }
+
+        T* slot = head->items() + head->begin;
+        T value = std::move(*slot);
+        std::destroy_at(slot);
+        if (++head->begin == head->end) {
+            unlink(head, nullptr);
+        }
+
+        --element_count;
+        return value;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return element_count == 0;
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return element_count;
+    }
+
+    void clear() noexcept {
+        while (head) {
+            Chunk* next = head->next;
+            destroy_chunk(head);
+            head = next;
+        }
+        tail = nullptr;
+        element_count = 0;
+    }
+
+    // Hand pooled chunk memory back to the allocator; only when empty
+    void shrink_to_fit() noexcept {
+        if (empty()) {
+            pool.release();
+        }
+    }
+
+    [[nodiscard]] const T& front() const {
+        if (empty()) {
+            throw std::out_of_range("List is empty");
+        }
+        return head->items()[head->begin];
+    }
+
+    [[nodiscard]] T& front() {
+        if (empty()) {
+            throw std::out_of_range("List is empty");
+        }
+        return head->items()[head->begin];
+    }
+
+    [[nodiscard]] const T& back() const {
+        if (empty()) {
+            throw std::out_of_range("List is empty");
+        }
+        return tail->items()[tail->end - 1];
+    }
+
+    [[nodiscard]] T& back() {
+        if (empty()) {
+            throw std::out_of_range("List is empty");
+        }
+        return tail->items()[tail->end - 1];
+    }
+
+    // Find first occurrence of value
+    [[nodiscard]] iterator find(const T& value) const {
+        for (Chunk* chunk = head; chunk; chunk = chunk->next) {
+            T* items = chunk->items();
+            for (std::uint32_t i = chunk->begin; i < chunk->end; ++i) {
+                if (items[i] == value) {
+                    return iterator(chunk, i);
+                }
+            }
+        }
+        return end();
+    }
+
+    // Remove first occurrence of value, closing the gap from whichever side
+    // of the chunk is shorter
+    bool remove(const T& value) {
+        Chunk* prev = nullptr;
+        for (Chunk* chunk = head; chunk; prev = chunk, chunk = chunk->next) {
+            T* items = chunk->items();
+            for (std::uint32_t i = chunk->begin; i < chunk->end; ++i) {
+                if (items[i] != value) {
+                    continue;
+                }
+                std::destroy_at(items + i);
+                if (i - chunk->begin < chunk->end - 1 - i) {
+                    for (std::uint32_t j = i; j > chunk->begin; --j) {
+                        relocate(items + j - 1, items + j);
+                    }
+                    ++chunk->begin;
+                } else {
+                    for (std::uint32_t j = i + 1; j < chunk->end; ++j) {
+                        relocate(items + j, items + j - 1);
+                    }
+                    --chunk->end;
+                }
+                --element_count;
+                rebalance(chunk, prev);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Apply function to each element; the inner loop runs over contiguous
+    // storage and can be vectorized
+    template <typename Func>
+    void for_each(Func&& func) {
+        for (Chunk* chunk = head; chunk; chunk = chunk->next) {
+            T* items = chunk->items();
+            for (std::uint32_t i = chunk->begin; i < chunk->end; ++i) {
+                func(items[i]);
+            }
+        }
+    }
+};
+
+#endif // UNROLLED_LIST_HPP
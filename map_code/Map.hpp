@@ -4,19 +4,31 @@
 
 #include <vector>
 #include <string>
+#include <memory>
 #include <utility>
+#include <algorithm>
 #include <stdexcept>
+#include "../memory_manage/container_stats.hpp"
+#include "../memory_manage/serialization.hpp"
 
-template<typename KeyType, typename ValueType>
+template<typename KeyType, typename ValueType,
+         typename Allocator = std::allocator<std::pair<KeyType, ValueType>>>
 class Map {
 private:
     // We'll use a vector of pairs to store our key-value pairs
-    std::vector<std::pair<KeyType, ValueType>> entries;
+    std::vector<std::pair<KeyType, ValueType>, Allocator> entries;
+    // Lookups are const, so the counters are mutable
+    [[no_unique_address]] mutable container_stats::InstanceStats<container_stats::Kind::map> stats;
     
     // Helper function to find a key's position
     int findKeyPosition(const KeyType& key) const;
 
 public:
+    Map() = default;
+
+    // Store the entries using the given allocator (e.g. a pmr arena)
+    explicit Map(const Allocator& alloc) : entries(alloc) {}
+
     // Put something in the map with a key
     void put(const KeyType& key, const ValueType& value);
     
@@ -40,34 +52,50 @@ public:
     
     // Get the number of entries in the map
     size_t size() const;
+
+    // Binary form: frame, then all keys followed by all values when both
+    // are trivially copyable, else each key followed by its value (see
+    // serialization.hpp). deserialize replaces the contents and leaves them
+    // untouched if the input is bad; keys are trusted to be unique
+    void serialize(serialization::Encoder& out) const;
+    void deserialize(serialization::Decoder& in);
+
+    // Scan lengths, reallocations and elements shifted by remove; all zero
+    // unless built with CONTAINER_STATS (see container_stats.hpp)
+    const container_stats::Counters& getStats() const { return stats.counters(); }
 };
 
 // Implementation of template methods
 
-template<typename KeyType, typename ValueType>
-int Map<KeyType, ValueType>::findKeyPosition(const KeyType& key) const {
+template<typename KeyType, typename ValueType, typename Allocator>
+int Map<KeyType, ValueType, Allocator>::findKeyPosition(const KeyType& key) const {
     for (size_t i = 0; i < entries.size(); i++) {
         if (entries[i].first == key) {
+            stats.scan(i + 1);
             return static_cast<int>(i);
         }
     }
+    stats.scan(entries.size());
     return -1;  // Key not found
 }
 
-template<typename KeyType, typename ValueType>
-void Map<KeyType, ValueType>::put(const KeyType& key, const ValueType& value) {
+template<typename KeyType, typename ValueType, typename Allocator>
+void Map<KeyType, ValueType, Allocator>::put(const KeyType& key, const ValueType& value) {
     int pos = findKeyPosition(key);
     if (pos != -1) {
         // Key already exists, update the value
         entries[pos].second = value;
     } else {
         // Add new key-value pair
+        size_t capacity = entries.capacity();
         entries.push_back(std::make_pair(key, value));
+        using Entry = std::pair<KeyType, ValueType>;
+        stats.grow(capacity * sizeof(Entry), entries.capacity() * sizeof(Entry), entries.size() - 1, sizeof(Entry));
     }
 }
 
-template<typename KeyType, typename ValueType>
-ValueType Map<KeyType, ValueType>::get(const KeyType& key) const {
+template<typename KeyType, typename ValueType, typename Allocator>
+ValueType Map<KeyType, ValueType, Allocator>::get(const KeyType& key) const {
     int pos = findKeyPosition(key);
     if (pos != -1) {
         return entries[pos].second;
@@ -75,21 +103,23 @@ ValueType Map<KeyType, ValueType>::get(const KeyType& key) const {
     throw std::out_of_range("Key not found in map");
 }
 
-template<typename KeyType, typename ValueType>
-bool Map<KeyType, ValueType>::contains(const KeyType& key) const {
+template<typename KeyType, typename ValueType, typename Allocator>
+bool Map<KeyType, ValueType, Allocator>::contains(const KeyType& key) const {
     return findKeyPosition(key) != -1;
 }
 
-template<typename KeyType, typename ValueType>
-void Map<KeyType, ValueType>::remove(const KeyType& key) {
+template<typename KeyType, typename ValueType, typename Allocator>
+void Map<KeyType, ValueType, Allocator>::remove(const KeyType& key) {
     int pos = findKeyPosition(key);
     if (pos != -1) {
         entries.erase(entries.begin() + pos);
+        size_t shifted = entries.size() - pos;
+        stats.move(shifted, shifted * sizeof(std::pair<KeyType, ValueType>));
     }
 }
 
-template<typename KeyType, typename ValueType>
-std::vector<KeyType> Map<KeyType, ValueType>::getKeys() const {
+template<typename KeyType, typename ValueType, typename Allocator>
+std::vector<KeyType> Map<KeyType, ValueType, Allocator>::getKeys() const {
     std::vector<KeyType> keys;
     for (const auto& entry : entries) {
         keys.push_back(entry.first);
@@ -97,8 +127,8 @@ std::vector<KeyType> Map<KeyType, ValueType>::getKeys() const {
     return keys;
 }
 
-template<typename KeyType, typename ValueType>
-std::vector<ValueType> Map<KeyType, ValueType>::getValues() const {
+template<typename KeyType, typename ValueType, typename Allocator>
+std::vector<ValueType> Map<KeyType, ValueType, Allocator>::getValues() const {
     std::vector<ValueType> values;
     for (const auto& entry : entries) {
         values.push_back(entry.second);
@@ -106,14 +136,56 @@ std::vector<ValueType> Map<KeyType, ValueType>::getValues() const {
     return values;
 }
 
-template<typename KeyType, typename ValueType>
-bool Map<KeyType, ValueType>::isEmpty() const {
+template<typename KeyType, typename ValueType, typename Allocator>
+bool Map<KeyType, ValueType, Allocator>::isEmpty() const {
     return entries.empty();
 }
 
-template<typename KeyType, typename ValueType>
-size_t Map<KeyType, ValueType>::size() const {
+template<typename KeyType, typename ValueType, typename Allocator>
+size_t Map<KeyType, ValueType, Allocator>::size() const {
     return entries.size();
 }
 
+// Key and value layouts share the frame's layout field, 16 bits each.
+// std::pair is never trivially copyable, so when keys and values both are
+// they go out as two packed sections, all keys then all values, which
+// load back with two bulk reads.
+template<typename KeyType, typename ValueType, typename Allocator>
+void Map<KeyType, ValueType, Allocator>::serialize(serialization::Encoder& out) const {
+    constexpr std::uint32_t layout = serialization::layout_tag<KeyType> << 16 | (serialization::layout_tag<ValueType> & 0xFFFF);
+    serialization::write_header(out, serialization::ContainerKind::map, layout, entries.size());
+    if constexpr (serialization::Bitwise<KeyType> && serialization::Bitwise<ValueType>) {
+        out.write_field(entries.begin(), entries.size(), [](const auto& entry) -> const KeyType& { return entry.first; });
+        out.write_field(entries.begin(), entries.size(), [](const auto& entry) -> const ValueType& { return entry.second; });
+    } else {
+        out.write_array(entries.data(), entries.size());
+    }
+}
+
+template<typename KeyType, typename ValueType, typename Allocator>
+void Map<KeyType, ValueType, Allocator>::deserialize(serialization::Decoder& in) {
+    constexpr std::uint32_t layout = serialization::layout_tag<KeyType> << 16 | (serialization::layout_tag<ValueType> & 0xFFFF);
+    std::uint64_t count = serialization::read_header(in, serialization::ContainerKind::map, layout);
+    using Entry = std::pair<KeyType, ValueType>;
+    std::vector<Entry, Allocator> incoming(entries.get_allocator());
+    if constexpr (serialization::Bitwise<KeyType> && serialization::Bitwise<ValueType>) {
+        // Keys straight into the entries, growing only as the input
+        // delivers them (as read_append does), then values into place
+        constexpr std::uint64_t trusted = (std::uint64_t{64} << 20) / sizeof(Entry) + 1;
+        incoming.reserve(static_cast<size_t>(std::min(count, trusted)));
+        while (incoming.size() < count) {
+            size_t old = incoming.size();
+            size_t k = static_cast<size_t>(std::min<std::uint64_t>(count - old, trusted));
+            incoming.resize(old + k);
+            in.read_field(incoming.begin() + old, k, [](Entry& entry) -> KeyType& { return entry.first; });
+        }
+        in.read_field(incoming.begin(), incoming.size(), [](Entry& entry) -> ValueType& { return entry.second; });
+    } else {
+        in.read_append(incoming, count);
+    }
+    stats.free(entries.capacity() * sizeof(Entry));
+    stats.allocation(incoming.capacity() * sizeof(Entry));
+    entries.swap(incoming);
+}
+
 #endif // MAP_HPP
\ No newline at end of file
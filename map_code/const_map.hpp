@@ -0,0 +1,249 @@
+#ifndef CONST_MAP_HPP
+#define CONST_MAP_HPP
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+// Read-only string-keyed map over a key set fixed at build time, laid out
+// by a minimal perfect hash computed in constexpr (hash-and-displace, the
+// CHD/PTHash family). Every key hashes to its own slot among exactly
+// size() slots, so a lookup is one hash, one displacement read and one key
+// compare, with no allocation and no probing.
+//
+// Keys are bucketed by the high half of their hash. Buckets are placed
+// largest first: a bucket of several keys searches for a displacement d
+// that sends all of its keys to free slots; a single-key bucket takes the
+// next free slot directly and records it as -(slot + 1).
+//
+// Build one with make_const_map, which is consteval: a duplicate key is a
+// compile error. Keys are string_views, so the strings must outlive the
+// map (literals do).
+//
+//     constexpr auto units = make_const_map<int>({{"celsius", 0}, {"kelvin", 1}});
+//     static_assert(units.get("kelvin") == 1);
+template <typename V, size_t N>
+class ConstMap {
+public:
+    using Entry = std::pair<std::string_view, V>;
+
+    constexpr explicit ConstMap(const std::array<Entry, N>& entries) {
+        if constexpr (N > 0) {
+            build(entries);
+        }
+    }
+
+    // Pointer to the value for `key`, or nullptr
+    constexpr const V* find(std::string_view key) const noexcept {
+        if constexpr (N == 0) {
+            return nullptr;
+        } else {
+            std::uint64_t h = hash(key, seed);
+            const Entry& entry = slots[slot_for(h, displacements[bucket_of(h)])];
+            return entry.first == key ? &entry.second : nullptr;
+        }
+    }
+
+    constexpr const V& get(std::string_view key) const {
+        const V* value = find(key);
+        if (!value) {
+            throw std::out_of_range("Key not found in map");
+        }
+        return *value;
+    }
+
+    constexpr bool contains(std::string_view key) const noexcept {
+        return find(key) != nullptr;
+    }
+
+    constexpr size_t size() const noexcept {
+        return N;
+    }
+
+    constexpr bool empty() const noexcept {
+        return N == 0;
+    }
+
+    // Entries in slot order, which is unrelated to insertion order
+    constexpr auto begin() const noexcept {
+        return slots.begin();
+    }
+
+    constexpr auto end() const noexcept {
+        return slots.end();
+    }
+
+    // Hash of `key`: 8 bytes per step, assembled so GCC folds each step into
+    // a single load at runtime
+    static constexpr std::uint64_t hash(std::string_view key, std::uint64_t seed) noexcept {
+        const char* p = key.data();
+        size_t n = key.size();
+        std::uint64_t h = seed ^ (n * 0x9E3779B97F4A7C15ull);
+        for (; n >= 8; p += 8, n -= 8) {
+            h = mix(h ^ word(p, 8));
+        }
+        if (n > 0) {
+            h = mix(h ^ word(p, n));
+        }
+        return mix(h);
+    }
+
+private:
+    static constexpr int max_displacement = 1 << 16;
+    static constexpr int max_seeds = 64;
+
+    static constexpr std::uint64_t mix(std::uint64_t x) noexcept {
+        x ^= x >> 32;
+        x *= 0xD6E8FEB86659FD93ull;
+        x ^= x >> 32;
+        return x;
+    }
+
+    // Raw pointer rather than string_view::operator[]: the build hashes
+    // every key in constexpr, where each checked call counts against GCC's
+    // operation limit
+    static constexpr std::uint64_t word(const char* p, size_t n) noexcept {
+        std::uint64_t w = 0;
+        for (size_t b = 0; b < n; ++b) {
+            w |= std::uint64_t{static_cast<unsigned char>(p[b])} << (8 * b);
+        }
+        return w;
+    }
+
+    // Multiply-shift range reduction instead of a division
+    static constexpr std::uint32_t reduce(std::uint32_t x) noexcept {
+        return static_cast<std::uint32_t>((std::uint64_t{x} * N) >> 32);
+    }
+
+    static constexpr std::uint32_t bucket_of(std::uint64_t h) noexcept {
+        return reduce(static_cast<std::uint32_t>(h >> 32));
+    }
+
+    static constexpr std::uint32_t slot_for(std::uint64_t h, std::int32_t d) noexcept {
+        if (d < 0) {
+            return static_cast<std::uint32_t>(-(d + 1));
+        }
+        return reduce(static_cast<std::uint32_t>(mix(h + static_cast<std::uint64_t>(d) * 0x9E3779B97F4A7C15ull)));
+    }
+
+    constexpr void build(const std::array<Entry, N>& entries) {
+        // Two distinct keys with the same 64-bit hash can never be
+        // separated; a new seed fixes that and any bucket that will not place
+        for (int attempt = 0; attempt < max_seeds; ++attempt) {
+            seed = 0x243F6A8885A308D3ull + attempt * 0x9E3779B97F4A7C15ull;
+            if (try_place(entries)) {
+                return;
+            }
+        }
+        throw std::logic_error("ConstMap: no perfect hash found");
+    }
+
+    // Counting passes and raw pointers only: a comparison sort, or a
+    // checked call per element access, costs too many constexpr operations
+    // at 10^4 keys
+    constexpr bool try_place(const std::array<Entry, N>& table) {
+        const Entry* entries = table.data();
+        std::array<std::uint64_t, N> hash_storage{};
+        std::array<std::uint32_t, N + 1> start_storage{};
+        std::uint64_t* hashes = hash_storage.data();
+        std::uint32_t* bucket_start = start_storage.data();
+        for (size_t i = 0; i < N; ++i) {
+            hashes[i] = hash(entries[i].first, seed);
+            ++bucket_start[bucket_of(hashes[i]) + 1];
+        }
+        std::uint32_t largest = 0;
+        for (size_t b = 0; b < N; ++b) {
+            largest = std::max(largest, bucket_start[b + 1]);
+            bucket_start[b + 1] += bucket_start[b];
+        }
+        // Key indices grouped by bucket
+        std::array<std::uint32_t, N> member_storage{};
+        std::array<std::uint32_t, N> fill_storage{};
+        std::uint32_t* members = member_storage.data();
+        std::uint32_t* fill = fill_storage.data();
+        for (size_t i = 0; i < N; ++i) {
+            std::uint32_t b = bucket_of(hashes[i]);
+            members[bucket_start[b] + fill[b]++] = static_cast<std::uint32_t>(i);
+        }
+
+        std::array<bool, N> taken_storage{};
+        std::array<std::uint32_t, N> placed_storage{};
+        bool* taken = taken_storage.data();
+        std::uint32_t* placed = placed_storage.data();
+        Entry* slot_entries = slots.data();
+        std::int32_t* displacement = displacements.data();
+        // Largest buckets first, while the table is still mostly empty
+        for (std::uint32_t count = largest; count >= 2; --count) {
+            for (size_t bucket = 0; bucket < N; ++bucket) {
+                if (bucket_start[bucket + 1] - bucket_start[bucket] != count) {
+                    continue;
+                }
+                const std::uint32_t* keys = members + bucket_start[bucket];
+                // Equal keys always share a bucket
+                for (size_t a = 0; a < count; ++a) {
+                    for (size_t b = a + 1; b < count; ++b) {
+                        if (entries[keys[a]].first == entries[keys[b]].first) {
+                            throw std::invalid_argument("ConstMap: duplicate key");
+                        }
+                    }
+                }
+                std::int32_t d = 0;
+                for (; d < max_displacement; ++d) {
+                    size_t k = 0;
+                    for (; k < count; ++k) {
+                        std::uint32_t slot = slot_for(hashes[keys[k]], d);
+                        if (taken[slot]) {
+                            break;
+                        }
+                        taken[slot] = true;
+                        placed[k] = slot;
+                    }
+                    if (k == count) {
+                        break;
+                    }
+                    for (size_t undo = 0; undo < k; ++undo) {
+                        taken[placed[undo]] = false;
+                    }
+                }
+                if (d == max_displacement) {
+                    return false;
+                }
+                displacement[bucket] = d;
+                for (size_t k = 0; k < count; ++k) {
+                    slot_entries[placed[k]] = entries[keys[k]];
+                }
+            }
+        }
+        size_t free_slot = 0;
+        for (size_t bucket = 0; bucket < N; ++bucket) {
+            if (bucket_start[bucket + 1] - bucket_start[bucket] != 1) {
+                continue;
+            }
+            while (taken[free_slot]) {
+                ++free_slot;
+            }
+            taken[free_slot] = true;
+            displacement[bucket] = -static_cast<std::int32_t>(free_slot) - 1;
+            slot_entries[free_slot] = entries[members[bucket_start[bucket]]];
+        }
+        return true;
+    }
+
+    std::array<Entry, N> slots{};
+    std::array<std::int32_t, N> displacements{};
+    std::uint64_t seed = 0;
+};
+
+// The braces form of construction, evaluated at compile time
+template <typename V, size_t N>
+consteval ConstMap<V, N> make_const_map(const std::pair<std::string_view, V> (&entries)[N]) {
+    std::array<std::pair<std::string_view, V>, N> table{};
+    std::copy(entries, entries + N, table.begin());
+    return ConstMap<V, N>(table);
+}
+
+#endif // CONST_MAP_HPP
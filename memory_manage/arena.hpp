@@ -0,0 +1,280 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <memory_resource>
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+// Allocation strategies for hot paths. Each one is a std::pmr::memory_resource,
+// so any allocator-aware container can be put on it through
+// std::pmr::polymorphic_allocator:
+//
+//     MonotonicArena arena;
+//     LinkedList<int, std::pmr::polymorphic_allocator<int>> list(&arena);
+//
+// None of the resources are thread-safe.
+
+namespace arena_detail {
+
+inline std::uintptr_t align_up(std::uintptr_t value, size_t alignment) noexcept {
+    return (value + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+}
+
+} // namespace arena_detail
+
+// Bump allocator: allocation is a pointer increment, deallocation is a no-op,
+// and everything is returned at once by release() or the destructor.
+// Blocks come from the upstream resource and double in size as it grows.
+class MonotonicArena : public std::pmr::memory_resource {
+public:
+    explicit MonotonicArena(size_t initial_block_size = 4096,
+                            std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : upstream(upstream), next_block_size(std::max<size_t>(initial_block_size, 64)) {}
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    ~MonotonicArena() override {
+        release();
+    }
+
+    // Returns every block to upstream; all earlier allocations become invalid
+    void release() noexcept {
+        while (blocks) {
+            Block* prev = blocks->prev;
+            upstream->deallocate(blocks, blocks->size, alignof(Block));
+            blocks = prev;
+        }
+        current = end = 0;
+        used = 0;
+    }
+
+    [[nodiscard]] size_t bytes_allocated() const noexcept {
+        return used;
+    }
+
+private:
+    struct alignas(std::max_align_t) Block {
+        Block* prev;
+        size_t size;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        std::uintptr_t start = arena_detail::align_up(current, alignment);
+        if (start + bytes > end || current == 0) {
+            add_block(bytes + alignment);
+            start = arena_detail::align_up(current, alignment);
+        }
+        current = start + bytes;
+        used += bytes;
+        return reinterpret_cast<void*>(start);
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    void add_block(size_t min_payload) {
+        size_t size = std::max(next_block_size, min_payload + sizeof(Block));
+        auto* block = static_cast<Block*>(upstream->allocate(size, alignof(Block)));
+        block->prev = blocks;
+        block->size = size;
+        blocks = block;
+        current = reinterpret_cast<std::uintptr_t>(block + 1);
+        end = reinterpret_cast<std::uintptr_t>(block) + size;
+        next_block_size = size * 2;
+    }
+
+    std::pmr::memory_resource* upstream;
+    Block* blocks = nullptr;
+    std::uintptr_t current = 0;
+    std::uintptr_t end = 0;
+    size_t next_block_size;
+    size_t used = 0;
+};
+
+// LIFO allocator over one fixed buffer. Freeing the most recent allocation
+// gives its space back immediately; anything else is reclaimed in bulk by
+// rolling back to a marker taken earlier.
+class StackArena : public std::pmr::memory_resource {
+public:
+    using Marker = size_t;
+
+    // Restores the arena to where it was when the scope was opened
+    class Scope {
+    public:
+        explicit Scope(StackArena& arena) noexcept : arena(arena), saved(arena.mark()) {}
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope() { arena.rollback(saved); }
+
+    private:
+        StackArena& arena;
+        Marker saved;
+    };
+
+    explicit StackArena(size_t capacity,
+                        std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : upstream(upstream), capacity(capacity),
+          buffer(static_cast<std::byte*>(upstream->allocate(capacity, alignof(std::max_align_t)))) {}
+
+    StackArena(const StackArena&) = delete;
+    StackArena& operator=(const StackArena&) = delete;
+
+    ~StackArena() override {
+        upstream->deallocate(buffer, capacity, alignof(std::max_align_t));
+    }
+
+    [[nodiscard]] Marker mark() const noexcept {
+        return top;
+    }
+
+    // Frees everything allocated after `marker` was taken
+    void rollback(Marker marker) noexcept {
+        if (marker < top) {
+            top = marker;
+        }
+    }
+
+    [[nodiscard]] size_t bytes_used() const noexcept {
+        return top;
+    }
+
+    [[nodiscard]] size_t bytes_free() const noexcept {
+        return capacity - top;
+    }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        auto base = reinterpret_cast<std::uintptr_t>(buffer);
+        std::uintptr_t start = arena_detail::align_up(base + top, alignment);
+        if (start + bytes > base + capacity) {
+            throw std::bad_alloc();
+        }
+        top = start + bytes - base;
+        return reinterpret_cast<void*>(start);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t) override {
+        auto* first = static_cast<std::byte*>(p);
+        if (first + bytes == buffer + top) {
+            top = static_cast<size_t>(first - buffer);
+        }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* upstream;
+    size_t capacity;
+    std::byte* buffer;
+    size_t top = 0;
+};
+
+// Pool of equally sized blocks carved out of larger chunks. Freed blocks go
+// onto an intrusive free-list and are handed out again in O(1). Requests that
+// do not fit a block are forwarded to the upstream resource.
+class BlockPool : public std::pmr::memory_resource {
+public:
+    explicit BlockPool(size_t block_size, size_t blocks_per_chunk = 256,
+                       std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : upstream(upstream),
+          block_size(arena_detail::align_up(std::max(block_size, sizeof(FreeBlock)), block_alignment)),
+          blocks_per_chunk(std::max<size_t>(blocks_per_chunk, 1)) {}
+
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    ~BlockPool() override {
+        release();
+    }
+
+    // Returns every chunk to upstream; outstanding blocks become invalid
+    void release() noexcept {
+        while (chunks) {
+            Chunk* prev = chunks->prev;
+            upstream->deallocate(chunks, chunks->size, alignof(Chunk));
+            chunks = prev;
+        }
+        free_list = nullptr;
+        carve = carve_end = nullptr;
+    }
+
+    [[nodiscard]] size_t block_bytes() const noexcept {
+        return block_size;
+    }
+
+private:
+    static constexpr size_t block_alignment = alignof(std::max_align_t);
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct alignas(std::max_align_t) Chunk {
+        Chunk* prev;
+        size_t size;
+    };
+
+    bool fits(size_t bytes, size_t alignment) const noexcept {
+        return bytes <= block_size && alignment <= block_alignment;
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        if (!fits(bytes, alignment)) {
+            return upstream->allocate(bytes, alignment);
+        }
+        if (free_list) {
+            FreeBlock* block = free_list;
+            free_list = block->next;
+            return block;
+        }
+        if (carve == carve_end) {
+            add_chunk();
+        }
+        void* block = carve;
+        carve += block_size;
+        return block;
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        if (!fits(bytes, alignment)) {
+            upstream->deallocate(p, bytes, alignment);
+            return;
+        }
+        auto* block = static_cast<FreeBlock*>(p);
+        block->next = free_list;
+        free_list = block;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    // Blocks are carved lazily so a fresh chunk costs no per-block work
+    void add_chunk() {
+        size_t size = sizeof(Chunk) + block_size * blocks_per_chunk;
+        auto* chunk = static_cast<Chunk*>(upstream->allocate(size, alignof(Chunk)));
+        chunk->prev = chunks;
+        chunk->size = size;
+        chunks = chunk;
+        carve = reinterpret_cast<std::byte*>(chunk + 1);
+        carve_end = carve + block_size * blocks_per_chunk;
+    }
+
+    std::pmr::memory_resource* upstream;
+    size_t block_size;
+    size_t blocks_per_chunk;
+    Chunk* chunks = nullptr;
+    FreeBlock* free_list = nullptr;
+    std::byte* carve = nullptr;
+    std::byte* carve_end = nullptr;
+};
+
+#endif // ARENA_HPP
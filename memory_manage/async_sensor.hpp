@@ -0,0 +1,192 @@
+#ifndef ASYNC_SENSOR_HPP
+#define ASYNC_SENSOR_HPP
+
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <cerrno>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+#include "event_loop.hpp"
+#include "temperature_sensor.hpp"
+#include "data_logger.hpp"
+
+// Sensors with I/O latency, polled by coroutines on an EventLoop.
+//
+// An AsyncTemperatureSensor answers read_async() after an injected delay,
+// in one of two ways:
+//   - timer: the reading coroutine sleeps on the loop's timer heap;
+//   - pipe: a simulated device writes the reading into a non-blocking pipe
+//     when the delay expires, and the coroutine waits on the read end
+//     through epoll like it would on a real device or socket.
+// Either way a pending read costs a suspended coroutine frame, not a
+// blocked thread, so one core can keep thousands of reads in flight.
+//
+// AsyncPoller polls each sensor on a fixed schedule and fans every reading
+// into one DataLogger. Everything runs on the loop's thread, so the logger
+// needs no locking.
+
+// Per-reading delay: base plus a uniform draw from [0, jitter)
+struct LatencyModel {
+    std::chrono::microseconds base{2000};
+    std::chrono::microseconds jitter{1000};
+
+    // Delay of a sensor's request k, from the sensor's own Philox stream
+    // (counter word 3 = 1 keeps it apart from the readings)
+    std::chrono::nanoseconds delay(int sensorId, std::uint64_t k) const {
+        philox::Counter w = philox::block({static_cast<std::uint32_t>(k), static_cast<std::uint32_t>(k >> 32),
+                                           static_cast<std::uint32_t>(sensorId), 1},
+                                          philox::make_key(TemperatureSensor::defaultSeed));
+        auto spread = std::chrono::nanoseconds(jitter).count();
+        return std::chrono::nanoseconds(base) +
+               std::chrono::nanoseconds(static_cast<std::int64_t>(w[0] * (1.0 / 4294967296.0) * spread));
+    }
+};
+
+enum class SensorBacking { timer, pipe };
+
+class AsyncTemperatureSensor {
+public:
+    AsyncTemperatureSensor(EventLoop& loop, int id, LatencyModel latency = {},
+                           SensorBacking backing = SensorBacking::timer, const SensorModel& model = {})
+        : loop(loop), sensor(id, model), latency(latency) {
+        if (backing == SensorBacking::pipe) {
+            if (pipe2(pipeFds, O_NONBLOCK | O_CLOEXEC) < 0) {
+                throw std::system_error(errno, std::generic_category(), "pipe2");
+            }
+            reader.emplace(loop, pipeFds[0]);
+        }
+    }
+
+    ~AsyncTemperatureSensor() {
+        reader.reset();
+        if (pipeFds[0] >= 0) {
+            ::close(pipeFds[0]);
+            ::close(pipeFds[1]);
+        }
+    }
+
+    // Registered with the loop by address
+    AsyncTemperatureSensor(const AsyncTemperatureSensor&) = delete;
+    AsyncTemperatureSensor& operator=(const AsyncTemperatureSensor&) = delete;
+
+    // One read in flight at a time per sensor
+    Task<float> read_async() {
+        auto delay = latency.delay(id(), requests++);
+        if (!reader) {
+            co_await loop.sleep_for(delay);
+            co_return sensor.readTemperature();
+        }
+        loop.call_at(EventLoop::clock::now() + delay, &AsyncTemperatureSensor::deviceRespond, this);
+        float value;
+        size_t got = 0;
+        while (got < sizeof(value)) {
+            size_t n = co_await reader->read_some(reinterpret_cast<char*>(&value) + got, sizeof(value) - got);
+            if (n == 0) {
+                throw std::runtime_error("sensor " + std::to_string(id()) + ": pipe closed");
+            }
+            got += n;
+        }
+        co_return value;
+    }
+
+    int id() const {
+        return sensor.id();
+    }
+
+private:
+    // The device side of the pipe: a 4-byte write is atomic, so the reader
+    // never sees half a reading
+    static void deviceRespond(void* self) {
+        auto* s = static_cast<AsyncTemperatureSensor*>(self);
+        float value = s->sensor.readTemperature();
+        if (::write(s->pipeFds[1], &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value))) {
+            throw std::system_error(errno, std::generic_category(), "sensor pipe write");
+        }
+    }
+
+    EventLoop& loop;
+    TemperatureSensor sensor;
+    LatencyModel latency;
+    int pipeFds[2] = {-1, -1};
+    std::optional<AsyncFd> reader;
+    std::uint64_t requests = 0;
+};
+
+struct PollStats {
+    std::uint64_t readings = 0;
+    std::uint64_t missed = 0;             // scheduled polls skipped because a read overran
+    std::int64_t totalLatenessNs = 0;     // poll start minus its scheduled time
+    std::int64_t maxLatenessNs = 0;
+
+    double meanLatenessNs() const {
+        return readings ? static_cast<double>(totalLatenessNs) / readings : 0.0;
+    }
+};
+
+class AsyncPoller {
+public:
+    AsyncPoller(EventLoop& loop, DataLogger& logger, std::chrono::nanoseconds interval)
+        : loop(loop), logger(logger), interval(interval) {
+        if (interval <= std::chrono::nanoseconds::zero()) {
+            throw std::invalid_argument("AsyncPoller: interval must be positive");
+        }
+    }
+
+    // Polls `sensor` every interval from now on. phase in [0, 1) offsets
+    // its first poll within the interval, to spread sensors out.
+    void add(AsyncTemperatureSensor& sensor, double phase = 0.0) {
+        auto offset = std::chrono::duration_cast<EventLoop::clock::duration>(interval * phase);
+        loop.spawn(poll(sensor, EventLoop::clock::now() + offset));
+    }
+
+    // Polling coroutines finish after their current read; run() returns
+    // once they all have
+    void stop() noexcept {
+        stopping = true;
+    }
+
+    const PollStats& stats() const {
+        return counters;
+    }
+
+private:
+    Task<void> poll(AsyncTemperatureSensor& sensor, EventLoop::clock::time_point next) {
+        using namespace std::chrono;
+        while (!stopping) {
+            co_await loop.sleep_until(next);
+            if (stopping) {
+                break;
+            }
+            auto started = EventLoop::clock::now();
+            std::int64_t late = duration_cast<nanoseconds>(started - next).count();
+            counters.totalLatenessNs += late;
+            counters.maxLatenessNs = std::max(counters.maxLatenessNs, late);
+
+            float value = co_await sensor.read_async();
+            auto now = EventLoop::clock::now();
+            logger.logReading(sensor.id(), value, duration_cast<milliseconds>(now.time_since_epoch()).count());
+            ++counters.readings;
+
+            // Keep to the schedule: polls whose slot has already passed are
+            // skipped, not bunched up
+            next += interval;
+            if (now > next) {
+                auto behind = (now - next) / interval + 1;
+                counters.missed += static_cast<std::uint64_t>(behind);
+                next += behind * interval;
+            }
+        }
+    }
+
+    EventLoop& loop;
+    DataLogger& logger;
+    std::chrono::nanoseconds interval;
+    bool stopping = false;
+    PollStats counters;
+};
+
+#endif // ASYNC_SENSOR_HPP
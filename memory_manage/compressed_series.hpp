@@ -0,0 +1,401 @@
+#ifndef COMPRESSED_SERIES_HPP
+#define COMPRESSED_SERIES_HPP
+
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <limits>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include "series_store.hpp"
+
+// Gorilla-style compression for (timestamp, float) series (Pelkonen et al.,
+// VLDB 2015). Timestamps are stored as delta-of-deltas, so a steady sampling
+// interval costs one bit per reading; values are XORed with their
+// predecessor and only the meaningful bits are written, so a reading that
+// repeats costs one bit and a small change costs a dozen or so.
+//
+// Each sealed block also keeps a SeriesStats summary, so whole-block
+// aggregates never touch the bitstream. Blocks that a time range only
+// partly covers are decoded (scalar, a block at a time) into a buffer,
+// which is then reduced with the vectorized kernels from series_store.hpp.
+namespace gorilla {
+
+// Appends bit fields most-significant bit first into 64-bit words
+class BitWriter {
+public:
+    // Writes the low `bits` bits of value (bits <= 64)
+    void write(std::uint64_t value, unsigned bits) {
+        if (bits == 0) {
+            return;
+        }
+        if (bits < 64) {
+            value &= (std::uint64_t{1} << bits) - 1;
+        }
+        unsigned offset = bit_count & 63;
+        if (offset == 0) {
+            words.push_back(0);
+        }
+        unsigned space = 64 - offset;
+        if (bits <= space) {
+            words.back() |= value << (space - bits);
+        } else {
+            words.back() |= value >> (bits - space);
+            words.push_back(value << (64 - (bits - space)));
+        }
+        bit_count += bits;
+    }
+
+    [[nodiscard]] size_t size_bits() const noexcept { return bit_count; }
+
+    // Hands over the words and resets the writer
+    std::vector<std::uint64_t> take() noexcept {
+        bit_count = 0;
+        return std::move(words);
+    }
+
+    [[nodiscard]] size_t capacity_bytes() const noexcept {
+        return words.capacity() * sizeof(std::uint64_t);
+    }
+
+private:
+    std::vector<std::uint64_t> words;
+    size_t bit_count = 0;
+};
+
+class BitReader {
+public:
+    explicit BitReader(const std::uint64_t* words) noexcept : words(words) {}
+
+    std::uint64_t read(unsigned bits) noexcept {
+        if (bits == 0) {
+            return 0;
+        }
+        size_t word = position >> 6;
+        unsigned offset = position & 63;
+        std::uint64_t value = words[word] << offset;
+        if (offset != 0 && offset + bits > 64) {
+            value |= words[word + 1] >> (64 - offset);
+        }
+        position += bits;
+        return value >> (64 - bits);
+    }
+
+    bool read_bit() noexcept {
+        bool bit = (words[position >> 6] >> (63 - (position & 63))) & 1;
+        ++position;
+        return bit;
+    }
+
+private:
+    const std::uint64_t* words;
+    size_t position = 0;
+};
+
+inline std::uint32_t float_bits(float value) noexcept {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof bits);
+    return bits;
+}
+
+inline float bits_float(std::uint32_t bits) noexcept {
+    float value;
+    std::memcpy(&value, &bits, sizeof value);
+    return value;
+}
+
+inline std::int64_t sign_extend(std::uint64_t value, unsigned bits) noexcept {
+    return static_cast<std::int64_t>(value << (64 - bits)) >> (64 - bits);
+}
+
+// An immutable, encoded run of readings with its summary
+struct Block {
+    std::int64_t first_timestamp = 0;
+    std::int64_t last_timestamp = 0;
+    std::uint32_t count = 0;
+    SeriesStats stats;
+    std::vector<std::uint64_t> bits;
+
+    [[nodiscard]] size_t bytes() const noexcept {
+        return sizeof(Block) + bits.size() * sizeof(std::uint64_t);
+    }
+
+    // Decodes all readings into the arrays, which must hold count entries
+    void decode(std::int64_t* timestamps, float* values) const noexcept {
+        if (count == 0) {
+            return;
+        }
+        BitReader reader(bits.data());
+        auto timestamp = static_cast<std::int64_t>(reader.read(64));
+        auto value = static_cast<std::uint32_t>(reader.read(32));
+        timestamps[0] = timestamp;
+        values[0] = bits_float(value);
+
+        std::int64_t delta = 0;
+        unsigned leading = 0;
+        unsigned meaningful = 0;
+        for (std::uint32_t i = 1; i < count; ++i) {
+            if (reader.read_bit()) {
+                std::int64_t dod;
+                if (!reader.read_bit()) {
+                    dod = sign_extend(reader.read(7), 7);
+                } else if (!reader.read_bit()) {
+                    dod = sign_extend(reader.read(9), 9);
+                } else if (!reader.read_bit()) {
+                    dod = sign_extend(reader.read(12), 12);
+                } else {
+                    dod = static_cast<std::int64_t>(reader.read(64));
+                }
+                delta += dod;
+            }
+            timestamp += delta;
+            timestamps[i] = timestamp;
+
+            if (reader.read_bit()) {
+                if (reader.read_bit()) {
+                    leading = static_cast<unsigned>(reader.read(5));
+                    meaningful = static_cast<unsigned>(reader.read(5)) + 1;
+                }
+                value ^= static_cast<std::uint32_t>(reader.read(meaningful)) << (32 - leading - meaningful);
+            }
+            values[i] = bits_float(value);
+        }
+    }
+};
+
+// Streaming encoder for one block
+class BlockEncoder {
+public:
+    void append(std::int64_t timestamp, float value) {
+        std::uint32_t bits = float_bits(value);
+        if (block.count == 0) {
+            writer.write(static_cast<std::uint64_t>(timestamp), 64);
+            writer.write(bits, 32);
+            block.first_timestamp = timestamp;
+        } else {
+            encode_timestamp(timestamp);
+            encode_value(bits);
+        }
+        block.last_timestamp = timestamp;
+        prev_timestamp = timestamp;
+        prev_bits = bits;
+        ++block.count;
+        block.stats.add(value);
+    }
+
+    [[nodiscard]] std::uint32_t count() const noexcept { return block.count; }
+    [[nodiscard]] std::int64_t last_timestamp() const noexcept { return block.last_timestamp; }
+    [[nodiscard]] const SeriesStats& stats() const noexcept { return block.stats; }
+    [[nodiscard]] size_t size_bits() const noexcept { return writer.size_bits(); }
+
+    // Finishes the block and resets the encoder for the next one
+    Block seal() {
+        block.bits = writer.take();
+        block.bits.shrink_to_fit();
+        Block sealed = std::move(block);
+        *this = BlockEncoder();
+        return sealed;
+    }
+
+    // Copy of the readings so far without sealing
+    Block snapshot() const {
+        Block copy = block;
+        BitWriter scratch = writer;
+        copy.bits = scratch.take();
+        return copy;
+    }
+
+private:
+    void encode_timestamp(std::int64_t timestamp) {
+        std::int64_t delta = timestamp - prev_timestamp;
+        std::int64_t dod = delta - prev_delta;
+        prev_delta = delta;
+        if (dod == 0) {
+            writer.write(0b0, 1);
+        } else if (dod >= -64 && dod <= 63) {
+            writer.write(0b10, 2);
+            writer.write(static_cast<std::uint64_t>(dod), 7);
+        } else if (dod >= -256 && dod <= 255) {
+            writer.write(0b110, 3);
+            writer.write(static_cast<std::uint64_t>(dod), 9);
+        } else if (dod >= -2048 && dod <= 2047) {
+            writer.write(0b1110, 4);
+            writer.write(static_cast<std::uint64_t>(dod), 12);
+        } else {
+            writer.write(0b1111, 4);
+            writer.write(static_cast<std::uint64_t>(dod), 64);
+        }
+    }
+
+    void encode_value(std::uint32_t bits) {
+        std::uint32_t x = bits ^ prev_bits;
+        if (x == 0) {
+            writer.write(0b0, 1);
+            return;
+        }
+        auto leading = static_cast<unsigned>(__builtin_clz(x));
+        auto trailing = static_cast<unsigned>(__builtin_ctz(x));
+        if (leading >= prev_leading && trailing >= prev_trailing) {
+            // Fits in the previous meaningful-bit window
+            writer.write(0b10, 2);
+            writer.write(x >> prev_trailing, 32 - prev_leading - prev_trailing);
+        } else {
+            unsigned meaningful = 32 - leading - trailing;
+            writer.write(0b11, 2);
+            writer.write(leading, 5);
+            writer.write(meaningful - 1, 5);
+            writer.write(x >> trailing, meaningful);
+            prev_leading = leading;
+            prev_trailing = trailing;
+        }
+    }
+
+    BitWriter writer;
+    Block block;
+    std::int64_t prev_timestamp = 0;
+    std::int64_t prev_delta = 0;
+    std::uint32_t prev_bits = 0;
+    unsigned prev_leading = 33;  // no window yet: forces the first one to be written
+    unsigned prev_trailing = 33;
+};
+
+} // namespace gorilla
+
+// Append-only compressed series for one sensor. Timestamps must not
+// decrease. Readings go into an open block that is sealed every
+// block_readings appends.
+class CompressedSeries {
+public:
+    explicit CompressedSeries(std::uint32_t block_readings = 1024) : block_readings(block_readings) {
+        if (block_readings == 0) {
+            throw std::invalid_argument("CompressedSeries needs at least one reading per block");
+        }
+    }
+
+    void append(std::int64_t timestamp, float value) {
+        if (size() > 0 && timestamp < last_timestamp()) {
+            throw std::invalid_argument("CompressedSeries timestamps must not decrease");
+        }
+        open.append(timestamp, value);
+        if (open.count() == block_readings) {
+            seal();
+        }
+    }
+
+    // Closes the open block early, e.g. before a long idle period
+    void seal() {
+        if (open.count() > 0) {
+            sealed_count += open.count();
+            sealed.push_back(open.seal());
+        }
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return sealed_count + open.count();
+    }
+
+    // Encoded bytes including per-block headers and summaries
+    [[nodiscard]] size_t bytes_used() const noexcept {
+        size_t total = (open.size_bits() + 7) / 8;
+        for (const auto& block : sealed) {
+            total += block.bytes();
+        }
+        return total;
+    }
+
+    [[nodiscard]] const std::vector<gorilla::Block>& blocks() const noexcept {
+        return sealed;
+    }
+
+    // Aggregate over everything, straight from the block summaries
+    [[nodiscard]] SeriesStats stats() const {
+        SeriesStats total;
+        for (const auto& block : sealed) {
+            total.merge(block.stats);
+        }
+        total.merge(open.stats());
+        return total;
+    }
+
+    // Aggregate over readings with from <= timestamp < to. Blocks entirely
+    // inside the range use their summary; the rest are decoded.
+    [[nodiscard]] SeriesStats stats(std::int64_t from, std::int64_t to) const {
+        SeriesStats total;
+        scan_blocks(from, to,
+                    [&](const gorilla::Block& block) { total.merge(block.stats); },
+                    [&](const std::int64_t*, const float* values, size_t n) {
+                        total.merge(series_kernels::stats(values, n));
+                    });
+        return total;
+    }
+
+    // Calls func(timestamps, values, n) with decoded runs covering
+    // from <= timestamp < to, in time order
+    template <typename Func>
+    void scan(std::int64_t from, std::int64_t to, Func&& func) const {
+        scan_blocks(from, to, nullptr, func);
+    }
+
+    // Decodes every reading, appending to the two vectors
+    void decode(std::vector<std::int64_t>& timestamps, std::vector<float>& values) const {
+        scan(std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max(),
+             [&](const std::int64_t* ts, const float* vs, size_t n) {
+                 timestamps.insert(timestamps.end(), ts, ts + n);
+                 values.insert(values.end(), vs, vs + n);
+             });
+    }
+
+private:
+    std::int64_t last_timestamp() const noexcept {
+        return open.count() > 0 ? open.last_timestamp() : sealed.back().last_timestamp;
+    }
+
+    // Whole blocks inside [from, to) go to on_block when it is callable;
+    // everything else is decoded and the in-range run goes to on_run
+    template <typename OnBlock, typename OnRun>
+    void scan_blocks(std::int64_t from, std::int64_t to, OnBlock&& on_block, OnRun&& on_run) const {
+        std::vector<std::int64_t> timestamps;
+        std::vector<float> values;
+        auto visit = [&](const gorilla::Block& block) {
+            if (block.count == 0 || block.last_timestamp < from || block.first_timestamp >= to) {
+                return;
+            }
+            if constexpr (!std::is_null_pointer_v<std::decay_t<OnBlock>>) {
+                if (block.first_timestamp >= from && block.last_timestamp < to) {
+                    on_block(block);
+                    return;
+                }
+            }
+            timestamps.resize(block.count);
+            values.resize(block.count);
+            block.decode(timestamps.data(), values.data());
+            auto first = std::lower_bound(timestamps.begin(), timestamps.end(), from);
+            auto last = std::lower_bound(first, timestamps.end(), to);
+            size_t begin = static_cast<size_t>(first - timestamps.begin());
+            size_t n = static_cast<size_t>(last - first);
+            if (n > 0) {
+                on_run(timestamps.data() + begin, values.data() + begin, n);
+            }
+        };
+        // Blocks are in time order, so skip straight to the first candidate
+        auto start = std::lower_bound(sealed.begin(), sealed.end(), from,
+                                      [](const gorilla::Block& block, std::int64_t t) {
+                                          return block.last_timestamp < t;
+                                      });
+        for (auto it = start; it != sealed.end() && it->first_timestamp < to; ++it) {
+            visit(*it);
+        }
+        if (open.count() > 0) {
+            visit(open.snapshot());
+        }
+    }
+
+    std::uint32_t block_readings;
+    std::vector<gorilla::Block> sealed;
+    gorilla::BlockEncoder open;
+    size_t sealed_count = 0;
+};
+
+#endif // COMPRESSED_SERIES_HPP
@@ -0,0 +1,460 @@
+#ifndef CONTAINER_STATS_HPP
+#define CONTAINER_STATS_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// Opt-in instrumentation for the containers: scan lengths, element moves,
+// reallocations, allocations/frees and peak memory, per instance and
+// summed per container kind, plus a tracking allocator and memory resource.
+//
+// Build with -DCONTAINER_STATS=1 (CMake: -DCONTAINERS_ENABLE_STATS=ON) to
+// turn it on. Otherwise every hook is an empty inline function and the
+// per-instance state is an empty [[no_unique_address]] member, so the
+// containers compile to exactly what they were without it. All translation
+// units of one program must agree on the setting.
+#ifndef CONTAINER_STATS
+#define CONTAINER_STATS 0
+#endif
+
+namespace container_stats {
+
+inline constexpr bool enabled = CONTAINER_STATS != 0;
+
+enum class Kind { queue, map, stack, linked_list, allocator };
+inline constexpr size_t kind_count = 5;
+
+inline const char* kind_name(Kind kind) noexcept {
+    constexpr const char* names[kind_count] = {"queue", "map", "stack", "linked_list", "allocator"};
+    return names[static_cast<size_t>(kind)];
+}
+
+// Bucket 0 counts zeros; bucket b counts values in [2^(b-1), 2^b)
+inline constexpr size_t histogram_buckets = 65;
+
+inline size_t bucket_of(std::uint64_t value) noexcept {
+    return static_cast<size_t>(std::bit_width(value));
+}
+
+template <typename Cell>
+struct BasicHistogram {
+    std::array<Cell, histogram_buckets> buckets{};
+    Cell samples{};
+    Cell total{};
+    Cell largest{};
+};
+
+template <typename Cell>
+struct BasicCounters {
+    Cell scans{};           // lookups
+    Cell probes{};          // elements compared by those lookups
+    Cell moves{};           // operations that shifted or relocated elements
+    Cell elements_moved{};
+    Cell bytes_moved{};
+    Cell reallocations{};   // buffer replaced by a bigger one
+    Cell allocations{};
+    Cell frees{};
+    Cell bytes_allocated{};
+    Cell bytes_freed{};
+    Cell live_bytes{};
+    Cell peak_bytes{};
+    BasicHistogram<Cell> scan_length;
+    BasicHistogram<Cell> move_length;  // elements per move
+    BasicHistogram<Cell> allocation_size;
+};
+
+using Histogram = BasicHistogram<std::uint64_t>;
+using Counters = BasicCounters<std::uint64_t>;
+// Shared between instances and threads; updated with relaxed atomics
+using SharedCounters = BasicCounters<std::atomic<std::uint64_t>>;
+
+namespace detail {
+
+inline std::uint64_t load(std::uint64_t cell) noexcept { return cell; }
+inline std::uint64_t load(const std::atomic<std::uint64_t>& cell) noexcept {
+    return cell.load(std::memory_order_relaxed);
+}
+
+// Both return the new value
+inline std::uint64_t add(std::uint64_t& cell, std::uint64_t v) noexcept { return cell += v; }
+inline std::uint64_t add(std::atomic<std::uint64_t>& cell, std::uint64_t v) noexcept {
+    return cell.fetch_add(v, std::memory_order_relaxed) + v;
+}
+inline std::uint64_t sub(std::uint64_t& cell, std::uint64_t v) noexcept { return cell -= v; }
+inline std::uint64_t sub(std::atomic<std::uint64_t>& cell, std::uint64_t v) noexcept {
+    return cell.fetch_sub(v, std::memory_order_relaxed) - v;
+}
+
+inline void raise(std::uint64_t& cell, std::uint64_t v) noexcept {
+    if (v > cell) {
+        cell = v;
+    }
+}
+inline void raise(std::atomic<std::uint64_t>& cell, std::uint64_t v) noexcept {
+    std::uint64_t current = cell.load(std::memory_order_relaxed);
+    while (current < v && !cell.compare_exchange_weak(current, v, std::memory_order_relaxed)) {
+    }
+}
+
+template <typename Cell>
+void record(BasicHistogram<Cell>& h, std::uint64_t value) noexcept {
+    add(h.buckets[bucket_of(value)], 1);
+    add(h.samples, 1);
+    add(h.total, value);
+    raise(h.largest, value);
+}
+
+template <typename C, typename F>
+void for_each_counter(C& c, F&& f) {
+    f("scans", c.scans);
+    f("probes", c.probes);
+    f("moves", c.moves);
+    f("elements_moved", c.elements_moved);
+    f("bytes_moved", c.bytes_moved);
+    f("reallocations", c.reallocations);
+    f("allocations", c.allocations);
+    f("frees", c.frees);
+    f("bytes_allocated", c.bytes_allocated);
+    f("bytes_freed", c.bytes_freed);
+    f("live_bytes", c.live_bytes);
+    f("peak_bytes", c.peak_bytes);
+}
+
+template <typename C, typename F>
+void for_each_histogram(C& c, F&& f) {
+    f("scan_length", c.scan_length);
+    f("move_length", c.move_length);
+    f("allocation_size", c.allocation_size);
+}
+
+} // namespace detail
+
+template <typename Cell>
+void record_scan(BasicCounters<Cell>& c, std::uint64_t probes) noexcept {
+    detail::add(c.scans, 1);
+    detail::add(c.probes, probes);
+    detail::record(c.scan_length, probes);
+}
+
+template <typename Cell>
+void record_move(BasicCounters<Cell>& c, std::uint64_t elements, std::uint64_t bytes) noexcept {
+    detail::add(c.moves, 1);
+    detail::add(c.elements_moved, elements);
+    detail::add(c.bytes_moved, bytes);
+    detail::record(c.move_length, elements);
+}
+
+template <typename Cell>
+void record_allocation(BasicCounters<Cell>& c, std::uint64_t bytes) noexcept {
+    detail::add(c.allocations, 1);
+    detail::add(c.bytes_allocated, bytes);
+    detail::raise(c.peak_bytes, detail::add(c.live_bytes, bytes));
+    detail::record(c.allocation_size, bytes);
+}
+
+template <typename Cell>
+void record_free(BasicCounters<Cell>& c, std::uint64_t bytes) noexcept {
+    detail::add(c.frees, 1);
+    detail::add(c.bytes_freed, bytes);
+    detail::sub(c.live_bytes, bytes);
+}
+
+// Totals for every instance of one kind; allocator totals cover every
+// TrackingAllocator and TrackingResource not given counters of their own
+inline SharedCounters& global(Kind kind) noexcept {
+    static SharedCounters counters[kind_count];
+    return counters[static_cast<size_t>(kind)];
+}
+
+inline Counters snapshot(const SharedCounters& shared) noexcept {
+    Counters out;
+    std::array<std::uint64_t, 12> values{};
+    size_t i = 0;
+    detail::for_each_counter(shared, [&](const char*, const auto& cell) { values[i++] = detail::load(cell); });
+    i = 0;
+    detail::for_each_counter(out, [&](const char*, auto& cell) { cell = values[i++]; });
+    auto copy = [](const BasicHistogram<std::atomic<std::uint64_t>>& from, Histogram& to) {
+        for (size_t b = 0; b < histogram_buckets; ++b) {
+            to.buckets[b] = detail::load(from.buckets[b]);
+        }
+        to.samples = detail::load(from.samples);
+        to.total = detail::load(from.total);
+        to.largest = detail::load(from.largest);
+    };
+    copy(shared.scan_length, out.scan_length);
+    copy(shared.move_length, out.move_length);
+    copy(shared.allocation_size, out.allocation_size);
+    return out;
+}
+
+// Zeroes the totals of one kind. Not synchronized with concurrent updates.
+inline void reset(SharedCounters& shared) noexcept {
+    detail::for_each_counter(shared, [](const char*, auto& cell) { cell.store(0, std::memory_order_relaxed); });
+    detail::for_each_histogram(shared, [](const char*, auto& h) {
+        for (auto& bucket : h.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        h.samples.store(0, std::memory_order_relaxed);
+        h.total.store(0, std::memory_order_relaxed);
+        h.largest.store(0, std::memory_order_relaxed);
+    });
+}
+
+// {"scans": 3, ..., "scan_length": {"samples": 3, "total": 9, "max": 5,
+//  "buckets": [[lo, hi, count], ...]}, ...}, listing non-empty buckets only
+inline void write_json(std::ostream& out, const Counters& c) {
+    out << "{";
+    const char* separator = "";
+    detail::for_each_counter(c, [&](const char* name, std::uint64_t value) {
+        out << separator << "\"" << name << "\": " << value;
+        separator = ", ";
+    });
+    detail::for_each_histogram(c, [&](const char* name, const Histogram& h) {
+        out << ", \"" << name << "\": {\"samples\": " << h.samples << ", \"total\": " << h.total
+            << ", \"max\": " << h.largest << ", \"buckets\": [";
+        const char* comma = "";
+        for (size_t b = 0; b < histogram_buckets; ++b) {
+            if (h.buckets[b] == 0) {
+                continue;
+            }
+            std::uint64_t lo = b == 0 ? 0 : std::uint64_t{1} << (b - 1);
+            std::uint64_t hi = b == 0 ? 0 : b == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << b) - 1;
+            out << comma << "[" << lo << ", " << hi << ", " << h.buckets[b] << "]";
+            comma = ", ";
+        }
+        out << "]}";
+    });
+    out << "}";
+}
+
+inline std::string to_json(const Counters& c) {
+    std::ostringstream out;
+    write_json(out, c);
+    return out.str();
+}
+
+// Every kind's totals: {"enabled": true, "queue": {...}, ..., "allocator": {...}}
+inline std::string snapshot_json() {
+    std::ostringstream out;
+    out << "{\"enabled\": " << (enabled ? "true" : "false");
+    for (size_t k = 0; k < kind_count; ++k) {
+        auto kind = static_cast<Kind>(k);
+        out << ", \"" << kind_name(kind) << "\": ";
+        write_json(out, snapshot(global(kind)));
+    }
+    out << "}";
+    return out.str();
+}
+
+// Per-container hooks. Each event updates the instance's counters and the
+// totals for its kind. Copies and moves start with fresh counters, except
+// that a move hands over the live byte count along with the memory.
+#if CONTAINER_STATS
+template <Kind K>
+class InstanceStats {
+public:
+    InstanceStats() noexcept = default;
+    InstanceStats(const InstanceStats&) noexcept {}
+    InstanceStats(InstanceStats&& other) noexcept { adopt(other); }
+
+    InstanceStats& operator=(const InstanceStats&) noexcept { return *this; }
+    InstanceStats& operator=(InstanceStats&& other) noexcept {
+        if (this != &other) {
+            free(local.live_bytes);
+            adopt(other);
+        }
+        return *this;
+    }
+
+    ~InstanceStats() {
+        free(local.live_bytes);
+    }
+
+    void scan(std::uint64_t probes) noexcept {
+        record_scan(local, probes);
+        record_scan(global(K), probes);
+    }
+
+    void move(std::uint64_t elements, std::uint64_t bytes) noexcept {
+        if (elements > 0) {
+            record_move(local, elements, bytes);
+            record_move(global(K), elements, bytes);
+        }
+    }
+
+    void allocation(std::uint64_t bytes) noexcept {
+        record_allocation(local, bytes);
+        record_allocation(global(K), bytes);
+    }
+
+    // Clamped to what this instance is known to hold, so memory it adopted
+    // without seeing the allocation cannot drive live_bytes below zero
+    void free(std::uint64_t bytes) noexcept {
+        if (bytes == 0) {
+            return;
+        }
+        bytes = std::min(bytes, local.live_bytes);
+        record_free(local, bytes);
+        record_free(global(K), bytes);
+    }
+
+    // A buffer of old_bytes (0: none) replaced by one of new_bytes, with
+    // `elements` elements relocated into it
+    void grow(std::uint64_t old_bytes, std::uint64_t new_bytes,
+              std::uint64_t elements, std::uint64_t element_bytes) noexcept {
+        if (old_bytes == new_bytes) {
+            return;
+        }
+        allocation(new_bytes);
+        if (old_bytes > 0) {
+            free(old_bytes);
+            detail::add(local.reallocations, 1);
+            detail::add(global(K).reallocations, 1);
+        }
+        move(elements, elements * element_bytes);
+    }
+
+    // Memory handed over from other without an allocation, e.g. a stolen
+    // buffer or spliced nodes
+    void transfer(InstanceStats& other, std::uint64_t bytes) noexcept {
+        bytes = std::min(bytes, other.local.live_bytes);
+        other.local.live_bytes -= bytes;
+        detail::raise(local.peak_bytes, local.live_bytes += bytes);
+    }
+
+    [[nodiscard]] const Counters& counters() const noexcept { return local; }
+
+private:
+    void adopt(InstanceStats& other) noexcept {
+        local.live_bytes = std::exchange(other.local.live_bytes, 0);
+        local.peak_bytes = local.live_bytes;
+    }
+
+    Counters local;
+};
+#else
+template <Kind K>
+class InstanceStats {
+public:
+    void scan(std::uint64_t) noexcept {}
+    void move(std::uint64_t, std::uint64_t) noexcept {}
+    void allocation(std::uint64_t) noexcept {}
+    void free(std::uint64_t) noexcept {}
+    void grow(std::uint64_t, std::uint64_t, std::uint64_t, std::uint64_t) noexcept {}
+    void transfer(InstanceStats&, std::uint64_t) noexcept {}
+
+    // Always zero
+    [[nodiscard]] const Counters& counters() const noexcept {
+        static const Counters none{};
+        return none;
+    }
+};
+#endif
+
+// Allocator adapter that records every allocation and free into counters
+// (the global allocator totals by default, or a caller-owned set, e.g. one
+// per container to get that container's exact footprint and peak). Works
+// with every container that takes an Allocator: Queue, Map, Stack and
+// LinkedList. When stats are disabled it only forwards to Base.
+template <typename T, typename Base = std::allocator<T>>
+class TrackingAllocator {
+    using BaseTraits = std::allocator_traits<Base>;
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    template <typename U>
+    struct rebind {
+        using other = TrackingAllocator<U, typename BaseTraits::template rebind_alloc<U>>;
+    };
+
+    TrackingAllocator() noexcept : counters(&global(Kind::allocator)) {}
+
+    explicit TrackingAllocator(SharedCounters& counters, const Base& base = Base()) noexcept
+        : base(base), counters(&counters) {}
+
+    template <typename U, typename B>
+    TrackingAllocator(const TrackingAllocator<U, B>& other) noexcept
+        : base(other.base), counters(other.counters) {}
+
+    T* allocate(size_t n) {
+        T* p = BaseTraits::allocate(base, n);
+        if constexpr (enabled) {
+            record_allocation(*counters, n * sizeof(T));
+        }
+        return p;
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if constexpr (enabled) {
+            record_free(*counters, n * sizeof(T));
+        }
+        BaseTraits::deallocate(base, p, n);
+    }
+
+    [[nodiscard]] SharedCounters& stats() const noexcept { return *counters; }
+
+    // Memory is interchangeable whenever the underlying allocators are
+    template <typename U, typename B>
+    friend bool operator==(const TrackingAllocator& a, const TrackingAllocator<U, B>& b) noexcept {
+        return a.base == b.base;
+    }
+
+private:
+    template <typename U, typename B>
+    friend class TrackingAllocator;
+
+    [[no_unique_address]] Base base;
+    SharedCounters* counters;
+};
+
+// The same for pmr users such as Graph
+class TrackingResource : public std::pmr::memory_resource {
+public:
+    explicit TrackingResource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource(),
+                              SharedCounters* counters = &global(Kind::allocator)) noexcept
+        : upstream(upstream), counters(counters) {}
+
+    [[nodiscard]] SharedCounters& stats() const noexcept { return *counters; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* p = upstream->allocate(bytes, alignment);
+        if constexpr (enabled) {
+            record_allocation(*counters, bytes);
+        }
+        return p;
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        if constexpr (enabled) {
+            record_free(*counters, bytes);
+        }
+        upstream->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* upstream;
+    SharedCounters* counters;
+};
+
+} // namespace container_stats
+
+#endif // CONTAINER_STATS_HPP
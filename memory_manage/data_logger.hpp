@@ -0,0 +1,120 @@
+#ifndef DATA_LOGGER_HPP
+#define DATA_LOGGER_HPP
+
+#include <map>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include "window_aggregates.hpp"
+#include "quantile_sketch.hpp"
+#include "rollup_tiers.hpp"
+
+// Live window settings applied to every sensor the logger sees
+struct WindowConfig {
+    size_t lastReadings = 60;         // sliding window over the newest readings
+    std::int64_t lastMillis = 60000;  // sliding window over recent time
+    std::int64_t tumbleMillis = 60000;  // fixed buckets
+    std::vector<std::int64_t> rollupMillis = {1000, 60000, 3600000};  // history tiers, finest first
+};
+
+// Incremental views of one sensor, updated on every logReading
+struct SensorWindows {
+    SlidingWindow byCount;
+    SlidingWindow byTime;
+    TumblingWindow tumbling;
+
+    explicit SensorWindows(const WindowConfig& config)
+        : byCount(SlidingWindow::last_readings(config.lastReadings)),
+          byTime(SlidingWindow::last_duration(config.lastMillis)),
+          tumbling(config.tumbleMillis) {}
+};
+
+// Collects readings per sensor. The full history is shared with analyzers
+// through getReadings; the window aggregates answer "last N" questions in
+// O(1) without touching it, and a t-digest per sensor answers percentiles.
+// Range aggregates over long histories go through per-sensor rollup tiers.
+class DataLogger {
+public:
+    explicit DataLogger(WindowConfig config = WindowConfig(), double digestCompression = 100.0)
+        : m_config(config), m_digestCompression(digestCompression) {}
+
+    // Timestamps the reading with the steady clock, in milliseconds
+    void logReading(int sensorId, float reading) {
+        auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        logReading(sensorId, reading, now);
+    }
+
+    // Timestamps must not decrease per sensor (std::invalid_argument)
+    void logReading(int sensorId, float reading, std::int64_t timestampMs) {
+        Channel& channel = channelFor(sensorId);
+        channel.rollups.append(timestampMs, reading);  // also appends to channel.readings
+        channel.windows.byCount.push(timestampMs, reading);
+        channel.windows.byTime.push(timestampMs, reading);
+        channel.windows.tumbling.push(timestampMs, reading);
+        channel.digest.add(reading);
+    }
+
+    // Read-only: the rollups index into the same vector
+    std::shared_ptr<const std::vector<float>> getReadings(int sensorId) {
+        return channelFor(sensorId).readings;
+    }
+
+    // nullptr if the sensor has never logged a reading
+    const SensorWindows* getWindows(int sensorId) const {
+        auto it = m_data.find(sensorId);
+        return it == m_data.end() ? nullptr : &it->second.windows;
+    }
+
+    // Percentile sketch over every reading of one sensor; nullptr if unknown
+    const TDigest* getDigest(int sensorId) const {
+        auto it = m_data.find(sensorId);
+        return it == m_data.end() ? nullptr : &it->second.digest;
+    }
+
+    // count/sum/min/max of one sensor's readings with fromMs <= t < toMs
+    RollupAggregate aggregate(int sensorId, std::int64_t fromMs, std::int64_t toMs) const {
+        auto it = m_data.find(sensorId);
+        return it == m_data.end() ? RollupAggregate() : it->second.rollups.aggregate(fromMs, toMs);
+    }
+
+    // All sensors merged, for fleet-wide percentiles
+    TDigest fleetDigest() const {
+        TDigest fleet(m_digestCompression);
+        for (const auto& [id, channel] : m_data) {
+            fleet.merge(channel.digest);
+        }
+        return fleet;
+    }
+
+    const WindowConfig& windowConfig() const {
+        return m_config;
+    }
+
+private:
+    struct Channel {
+        std::shared_ptr<std::vector<float>> readings;  // shared with rollups, which appends to it
+        SensorWindows windows;
+        TDigest digest;
+        RollupSeries rollups;
+    };
+
+    Channel& channelFor(int sensorId) {
+        auto it = m_data.find(sensorId);
+        if (it == m_data.end()) {
+            auto readings = std::make_shared<std::vector<float>>();
+            it = m_data.emplace(sensorId, Channel{readings,
+                                                  SensorWindows(m_config),
+                                                  TDigest(m_digestCompression),
+                                                  RollupSeries(m_config.rollupMillis, readings)}).first;
+        }
+        return it->second;
+    }
+
+    WindowConfig m_config;
+    double m_digestCompression;
+    std::map<int, Channel> m_data;
+};
+
+#endif // DATA_LOGGER_HPP
@@ -0,0 +1,239 @@
+// event_loop.cpp
+#include "event_loop.hpp"
+#include <array>
+#include <string>
+#include <system_error>
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace {
+
+[[noreturn]] void throw_errno(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+// epoll_event.data.ptr for the timerfd; AsyncFds register themselves
+char timer_tag;
+
+} // namespace
+
+void event_loop_detail::PromiseBase::finish_detached(PromiseBase& promise) noexcept {
+    EventLoop& loop = *promise.loop;
+    loop.unlink(promise);
+    if (promise.error && !loop.failure) {
+        loop.failure = promise.error;
+        loop.stopping = true;
+    }
+    promise.self.destroy();
+}
+
+EventLoop::EventLoop() {
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0) {
+        throw_errno("epoll_create1");
+    }
+    timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timer_fd < 0) {
+        int saved = errno;
+        ::close(epoll_fd);
+        errno = saved;
+        throw_errno("timerfd_create");
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.ptr = &timer_tag;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, timer_fd, &event) < 0) {
+        int saved = errno;
+        ::close(timer_fd);
+        ::close(epoll_fd);
+        errno = saved;
+        throw_errno("epoll_ctl timerfd");
+    }
+}
+
+EventLoop::~EventLoop() {
+    // Destroying a suspended task also destroys the Tasks it was awaiting
+    while (tasks) {
+        event_loop_detail::PromiseBase* promise = tasks;
+        unlink(*promise);
+        promise->self.destroy();
+    }
+    // Closing the epoll descriptor drops their registrations
+    for (AsyncFd* fd = fds; fd; fd = fd->next) {
+        fd->loop = nullptr;
+        fd->waiter = nullptr;
+    }
+    ::close(timer_fd);
+    ::close(epoll_fd);
+}
+
+void EventLoop::link(event_loop_detail::PromiseBase& promise) noexcept {
+    promise.loop = this;
+    promise.prev = nullptr;
+    promise.next = tasks;
+    if (tasks) {
+        tasks->prev = &promise;
+    }
+    tasks = &promise;
+    ++task_count;
+}
+
+void EventLoop::unlink(event_loop_detail::PromiseBase& promise) noexcept {
+    if (promise.prev) {
+        promise.prev->next = promise.next;
+    } else {
+        tasks = promise.next;
+    }
+    if (promise.next) {
+        promise.next->prev = promise.prev;
+    }
+    promise.prev = promise.next = nullptr;
+    --task_count;
+}
+
+void EventLoop::call_at(clock::time_point deadline, void (*fn)(void*), void* context) {
+    add_timer(deadline, nullptr, fn, context);
+}
+
+void EventLoop::add_timer(clock::time_point deadline, std::coroutine_handle<> h, void (*fn)(void*), void* context) {
+    timers.push(Timer{deadline, next_sequence++, h, fn, context});
+}
+
+// Re-arms only when the earliest deadline moved; most timers added land
+// behind it
+void EventLoop::arm_timerfd() {
+    clock::time_point next = timers.empty() ? clock::time_point::max() : timers.top().deadline;
+    if (next == armed_for) {
+        return;
+    }
+    itimerspec spec{};
+    if (next != clock::time_point::max()) {
+        // steady_clock is CLOCK_MONOTONIC on Linux, so the deadline is
+        // already in timerfd's clock; zero would disarm, so clamp to 1 ns
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(next.time_since_epoch()).count();
+        ns = std::max<std::int64_t>(ns, 1);
+        spec.it_value.tv_sec = static_cast<time_t>(ns / 1'000'000'000);
+        spec.it_value.tv_nsec = static_cast<long>(ns % 1'000'000'000);
+    }
+    if (timerfd_settime(timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr) < 0) {
+        throw_errno("timerfd_settime");
+    }
+    armed_for = next;
+    ++counters.timerfd_arms;
+}
+
+void EventLoop::fire_due_timers() {
+    clock::time_point now = clock::now();
+    while (!timers.empty() && timers.top().deadline <= now && !stopping) {
+        Timer timer = timers.top();
+        timers.pop();
+        ++counters.timers_fired;
+        if (timer.handle) {
+            timer.handle.resume();
+        } else {
+            timer.fn(timer.context);
+        }
+    }
+}
+
+void EventLoop::run() {
+    stopping = false;
+    std::array<epoll_event, 256> events;
+    while (!stopping && task_count > 0) {
+        // Tasks made ready during this pass wait for the next one, so a
+        // task that keeps yielding cannot starve timers and descriptors
+        resuming.swap(ready);
+        for (auto h : resuming) {
+            if (stopping) {
+                ready.push_back(h);
+                continue;
+            }
+            h.resume();
+        }
+        resuming.clear();
+        if (stopping || task_count == 0) {
+            break;
+        }
+
+        fire_due_timers();
+        if (stopping || task_count == 0) {
+            break;
+        }
+        arm_timerfd();
+        int n = epoll_wait(epoll_fd, events.data(), static_cast<int>(events.size()), ready.empty() ? -1 : 0);
+        ++counters.epoll_waits;
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw_errno("epoll_wait");
+        }
+        for (int i = 0; i < n; ++i) {
+            if (events[i].data.ptr == &timer_tag) {
+                std::uint64_t expirations;
+                [[maybe_unused]] ssize_t r = ::read(timer_fd, &expirations, sizeof(expirations));
+                armed_for = clock::time_point::max();
+            } else {
+                ++counters.fd_wakeups;
+                static_cast<AsyncFd*>(events[i].data.ptr)->on_ready();
+            }
+        }
+        fire_due_timers();
+    }
+    if (failure) {
+        std::rethrow_exception(std::exchange(failure, nullptr));
+    }
+}
+
+AsyncFd::AsyncFd(EventLoop& loop, int fd) : loop(&loop), descriptor(fd) {
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+    event.data.ptr = this;
+    if (epoll_ctl(loop.epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+        throw_errno("epoll_ctl add");
+    }
+    next = loop.fds;
+    if (next) {
+        next->prev = this;
+    }
+    loop.fds = this;
+}
+
+AsyncFd::~AsyncFd() {
+    if (!loop) {
+        return;
+    }
+    epoll_ctl(loop->epoll_fd, EPOLL_CTL_DEL, descriptor, nullptr);
+    if (prev) {
+        prev->next = next;
+    } else {
+        loop->fds = next;
+    }
+    if (next) {
+        next->prev = prev;
+    }
+}
+
+void AsyncFd::on_ready() noexcept {
+    readable = true;
+    if (waiter) {
+        std::exchange(waiter, nullptr).resume();
+    }
+}
+
+Task<size_t> AsyncFd::read_some(void* data, size_t n) {
+    for (;;) {
+        co_await ReadableAwaiter{*this};
+        ssize_t got = ::read(descriptor, data, n);
+        if (got >= 0) {
+            co_return static_cast<size_t>(got);
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            readable = false;
+        } else if (errno != EINTR) {
+            throw_errno("read");
+        }
+    }
+}
@@ -0,0 +1,278 @@
+#ifndef EVENT_LOOP_HPP
+#define EVENT_LOOP_HPP
+
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <queue>
+#include <utility>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Single-threaded coroutine runtime over epoll (Linux only).
+//
+// Coroutines are Task<T>: lazily started, awaited by a parent coroutine or
+// handed to EventLoop::spawn to run detached. A suspended coroutine waits
+// on one of two things:
+//   - a deadline: every sleeping coroutine sits in one min-heap, and a
+//     single timerfd is armed for the earliest deadline, so ten thousand
+//     sleepers cost one descriptor;
+//   - a descriptor: AsyncFd registers it once, edge-triggered, with epoll
+//     pointing straight at the AsyncFd, so waking a reader needs no lookup.
+//
+// run() drives everything on the calling thread until stop() is called or
+// no spawned task is left. An exception escaping a detached task ends run()
+// and is rethrown from it. Destroying the loop destroys any unfinished
+// detached tasks and detaches the AsyncFds still registered, so those may
+// be destroyed before or after the loop. Whatever a pending timer callback
+// points at must outlive the next run().
+
+class EventLoop;
+class AsyncFd;
+
+namespace event_loop_detail {
+
+struct PromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+    // Set for detached tasks, which are linked into the loop's task list
+    EventLoop* loop = nullptr;
+    PromiseBase* prev = nullptr;
+    PromiseBase* next = nullptr;
+    std::coroutine_handle<> self;
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept {
+            PromiseBase& promise = h.promise();
+            if (promise.loop) {
+                finish_detached(promise);
+                return std::noop_coroutine();
+            }
+            return promise.continuation ? promise.continuation : std::noop_coroutine();
+        }
+        void await_resume() noexcept {}
+    };
+
+    FinalAwaiter final_suspend() noexcept { return {}; }
+
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+
+    // Unlinks a finished detached task, hands its error to the loop and
+    // frees the frame
+    static void finish_detached(PromiseBase& promise) noexcept;
+};
+
+} // namespace event_loop_detail
+
+template <typename T = void>
+class [[nodiscard]] Task {
+public:
+    struct promise_type : event_loop_detail::PromiseBase {
+        T value{};
+
+        Task get_return_object() noexcept {
+            auto h = std::coroutine_handle<promise_type>::from_promise(*this);
+            self = h;
+            return Task(h);
+        }
+
+        template <typename U>
+        void return_value(U&& v) {
+            value = std::forward<U>(v);
+        }
+    };
+
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+    ~Task() { reset(); }
+
+    // Awaiting starts the task and resumes the awaiter when it finishes
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+    T await_resume() {
+        if (handle.promise().error) {
+            std::rethrow_exception(handle.promise().error);
+        }
+        return std::move(handle.promise().value);
+    }
+
+private:
+    friend class EventLoop;
+    explicit Task(std::coroutine_handle<promise_type> h) noexcept : handle(h) {}
+
+    void reset() noexcept {
+        if (handle) {
+            handle.destroy();
+            handle = nullptr;
+        }
+    }
+
+    std::coroutine_handle<promise_type> release() noexcept { return std::exchange(handle, nullptr); }
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+template <>
+struct Task<void>::promise_type : event_loop_detail::PromiseBase {
+    Task get_return_object() noexcept {
+        auto h = std::coroutine_handle<promise_type>::from_promise(*this);
+        self = h;
+        return Task(h);
+    }
+
+    void return_void() noexcept {}
+};
+
+template <>
+inline void Task<void>::await_resume() {
+    if (handle.promise().error) {
+        std::rethrow_exception(handle.promise().error);
+    }
+}
+
+class EventLoop {
+public:
+    using clock = std::chrono::steady_clock;
+
+    struct Stats {
+        std::uint64_t epoll_waits = 0;
+        std::uint64_t timers_fired = 0;
+        std::uint64_t fd_wakeups = 0;
+        std::uint64_t timerfd_arms = 0;
+    };
+
+    EventLoop();
+    ~EventLoop();
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    // Runs the task detached; it first resumes inside run()
+    template <typename T>
+    void spawn(Task<T> task) {
+        auto h = task.release();
+        link(h.promise());
+        ready.push_back(h);
+    }
+
+    // Runs until stop() or until no spawned task is left
+    void run();
+
+    // Makes run() return after the current step; tasks stay suspended
+    void stop() noexcept { stopping = true; }
+
+    // Plain callback at a deadline, for simulated devices
+    void call_at(clock::time_point deadline, void (*fn)(void*), void* context);
+
+    [[nodiscard]] size_t live_tasks() const noexcept { return task_count; }
+    [[nodiscard]] size_t pending_timers() const noexcept { return timers.size(); }
+    [[nodiscard]] const Stats& stats() const noexcept { return counters; }
+
+    struct SleepAwaiter {
+        EventLoop& loop;
+        clock::time_point deadline;
+
+        bool await_ready() const noexcept { return deadline <= clock::now(); }
+        void await_suspend(std::coroutine_handle<> h) { loop.add_timer(deadline, h, nullptr, nullptr); }
+        void await_resume() const noexcept {}
+    };
+
+    SleepAwaiter sleep_until(clock::time_point deadline) noexcept { return {*this, deadline}; }
+    SleepAwaiter sleep_for(clock::duration d) noexcept { return {*this, clock::now() + d}; }
+
+    // Lets every other ready task run first
+    struct YieldAwaiter {
+        EventLoop& loop;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h) { loop.ready.push_back(h); }
+        void await_resume() const noexcept {}
+    };
+
+    YieldAwaiter yield() noexcept { return {*this}; }
+
+private:
+    friend class AsyncFd;
+    friend struct event_loop_detail::PromiseBase;
+
+    struct Timer {
+        clock::time_point deadline;
+        std::uint64_t sequence;  // FIFO among equal deadlines
+        std::coroutine_handle<> handle;
+        void (*fn)(void*);
+        void* context;
+
+        bool operator>(const Timer& other) const noexcept {
+            return deadline != other.deadline ? deadline > other.deadline : sequence > other.sequence;
+        }
+    };
+
+    void add_timer(clock::time_point deadline, std::coroutine_handle<> h, void (*fn)(void*), void* context);
+    void arm_timerfd();
+    void fire_due_timers();
+    void link(event_loop_detail::PromiseBase& promise) noexcept;
+    void unlink(event_loop_detail::PromiseBase& promise) noexcept;
+
+    int epoll_fd = -1;
+    int timer_fd = -1;
+    bool stopping = false;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<>> timers;
+    std::uint64_t next_sequence = 0;
+    clock::time_point armed_for = clock::time_point::max();
+    std::vector<std::coroutine_handle<>> ready;
+    std::vector<std::coroutine_handle<>> resuming;
+    event_loop_detail::PromiseBase* tasks = nullptr;  // detached, unfinished
+    AsyncFd* fds = nullptr;  // registered, detached in ~EventLoop
+    size_t task_count = 0;
+    std::exception_ptr failure;
+    Stats counters;
+};
+
+// Non-blocking descriptor registered with a loop for as long as both live.
+// One coroutine at a time may wait on it. Does not own the descriptor.
+class AsyncFd {
+public:
+    AsyncFd(EventLoop& loop, int fd);
+    ~AsyncFd();
+    AsyncFd(const AsyncFd&) = delete;
+    AsyncFd& operator=(const AsyncFd&) = delete;
+
+    [[nodiscard]] int fd() const noexcept { return descriptor; }
+
+    // Reads up to n bytes, suspending while none are available; returns 0
+    // at end of file
+    Task<size_t> read_some(void* data, size_t n);
+
+private:
+    friend class EventLoop;
+
+    struct ReadableAwaiter {
+        AsyncFd& fd;
+        bool await_ready() const noexcept { return fd.readable; }
+        void await_suspend(std::coroutine_handle<> h) noexcept { fd.waiter = h; }
+        void await_resume() const noexcept {}
+    };
+
+    void on_ready() noexcept;
+
+    EventLoop* loop;  // null once the loop is gone
+    AsyncFd* prev = nullptr;
+    AsyncFd* next = nullptr;
+    int descriptor;
+    bool readable = true;  // edge-triggered: assume data until read says EAGAIN
+    std::coroutine_handle<> waiter;
+};
+
+#endif // EVENT_LOOP_HPP
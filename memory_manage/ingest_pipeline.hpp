@@ -0,0 +1,372 @@
+#ifndef INGEST_PIPELINE_HPP
+#define INGEST_PIPELINE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "temperature_sensor.hpp"
+#include "series_store.hpp"
+#include "../queue_code/spsc_ring.hpp"
+
+// Streaming path from sensors to published per-sensor summaries:
+//
+//     pollers --SPSC rings--> aggregators --SPSC rings--> sink
+//
+// Each poller owns a contiguous range of sensors and reads them in rounds.
+// Readings are routed to aggregator (sensor % aggregators), so every sensor
+// is summarised by exactly one thread and no summary needs locking. Every
+// poller/aggregator pair has its own ring, which keeps each ring strictly
+// single-producer single-consumer.
+//
+// Readings cross each ring in batches of batch_size. Rings are bounded, so a
+// slow stage makes the stage before it wait (counted as a stall) instead of
+// buffering without limit. Aggregators publish one summary per sensor every
+// publish_interval; the sink keeps the latest one and forwards it to an
+// optional callback.
+
+struct SensorReading {
+    std::uint32_t sensor;
+    float value;
+    std::int64_t timestamp_ns;  // since the pipeline started
+};
+
+struct SensorSummary {
+    std::uint32_t sensor;
+    std::int64_t window_end_ns;
+    SeriesStats stats;  // readings in the window that ended at window_end_ns
+};
+
+struct IngestConfig {
+    size_t sensors = 10000;
+    unsigned pollers = 2;
+    unsigned aggregators = 2;
+    size_t batch_size = 64;       // readings per hand-off between stages
+    size_t ring_capacity = 8192;  // per ring; bounds memory in flight
+    double poll_rate_hz = 0.0;    // rounds per second per poller; 0 = unthrottled
+    std::chrono::milliseconds publish_interval{100};
+};
+
+struct StageStats {
+    const char* name;
+    std::uint64_t items;       // readings (or summaries) the stage has handled
+    std::uint64_t stalls;      // times the stage found its output ring full
+    size_t queue_depth;        // items waiting in the stage's input rings
+    double items_per_second;   // since start()
+};
+
+class IngestPipeline {
+public:
+    using Publisher = std::function<void(const SensorSummary&)>;
+
+    // publish, if set, runs on the sink thread for every summary
+    explicit IngestPipeline(IngestConfig config, Publisher publish = nullptr)
+        : config(validated(config)), publisher(std::move(publish)),
+          poll_counters(this->config.pollers), aggregate_counters(this->config.aggregators),
+          latest_results(this->config.sensors) {
+        for (size_t i = 0; i < size_t{this->config.pollers} * this->config.aggregators; ++i) {
+            reading_rings.push_back(std::make_unique<SpscRing<SensorReading>>(this->config.ring_capacity));
+        }
+        for (unsigned a = 0; a < this->config.aggregators; ++a) {
+            summary_rings.push_back(std::make_unique<SpscRing<SensorSummary>>(this->config.ring_capacity));
+        }
+    }
+
+    IngestPipeline(const IngestPipeline&) = delete;
+    IngestPipeline& operator=(const IngestPipeline&) = delete;
+
+    ~IngestPipeline() {
+        stop();
+    }
+
+    void start() {
+        if (started) {
+            throw std::logic_error("IngestPipeline can only be started once");
+        }
+        started = true;
+        start_time = std::chrono::steady_clock::now();
+        running.store(true, std::memory_order_relaxed);
+        sink_thread = std::thread(&IngestPipeline::run_sink, this);
+        for (unsigned a = 0; a < config.aggregators; ++a) {
+            aggregator_threads.emplace_back(&IngestPipeline::run_aggregator, this, a);
+        }
+        for (unsigned p = 0; p < config.pollers; ++p) {
+            poller_threads.emplace_back(&IngestPipeline::run_poller, this, p);
+        }
+    }
+
+    // Stops polling, lets everything in flight reach the sink, then joins
+    void stop() {
+        if (!started || stopped) {
+            return;
+        }
+        running.store(false, std::memory_order_relaxed);
+        join_all(poller_threads);
+        pollers_done.store(true, std::memory_order_release);
+        join_all(aggregator_threads);
+        aggregators_done.store(true, std::memory_order_release);
+        sink_thread.join();
+        stop_time = std::chrono::steady_clock::now();
+        stopped = true;
+    }
+
+    // One entry per stage: poll, aggregate, sink
+    [[nodiscard]] std::vector<StageStats> stats() const {
+        double seconds = std::chrono::duration<double>(
+            (stopped ? stop_time : std::chrono::steady_clock::now()) - start_time).count();
+        auto rate = [seconds](std::uint64_t items) { return seconds > 0 ? items / seconds : 0.0; };
+
+        StageStats poll{"poll", 0, 0, 0, 0.0};
+        for (const auto& c : poll_counters) {
+            poll.items += c.items.load(std::memory_order_relaxed);
+            poll.stalls += c.stalls.load(std::memory_order_relaxed);
+        }
+        StageStats aggregate{"aggregate", 0, 0, 0, 0.0};
+        for (const auto& c : aggregate_counters) {
+            aggregate.items += c.items.load(std::memory_order_relaxed);
+            aggregate.stalls += c.stalls.load(std::memory_order_relaxed);
+        }
+        for (const auto& ring : reading_rings) {
+            aggregate.queue_depth += ring->size_approx();
+        }
+        StageStats sink{"sink", sink_counter.items.load(std::memory_order_relaxed), 0, 0, 0.0};
+        for (const auto& ring : summary_rings) {
+            sink.queue_depth += ring->size_approx();
+        }
+        poll.items_per_second = rate(poll.items);
+        aggregate.items_per_second = rate(aggregate.items);
+        sink.items_per_second = rate(sink.items);
+        return {poll, aggregate, sink};
+    }
+
+    // Most recent published window for a sensor, if any
+    [[nodiscard]] std::optional<SensorSummary> latest(size_t sensor) const {
+        std::lock_guard<std::mutex> lock(results_mutex);
+        const SensorSummary& summary = latest_results.at(sensor);
+        if (summary.stats.count == 0) {
+            return std::nullopt;
+        }
+        return summary;
+    }
+
+    [[nodiscard]] const IngestConfig& configuration() const noexcept {
+        return config;
+    }
+
+private:
+    struct alignas(64) Counter {
+        std::atomic<std::uint64_t> items{0};
+        std::atomic<std::uint64_t> stalls{0};
+    };
+
+    static IngestConfig validated(IngestConfig config) {
+        if (config.sensors == 0 || config.pollers == 0 || config.aggregators == 0 || config.batch_size == 0) {
+            throw std::invalid_argument("IngestConfig needs at least one sensor, poller, aggregator and batch slot");
+        }
+        if (config.sensors > UINT32_MAX) {
+            throw std::invalid_argument("IngestConfig sensor ids must fit in 32 bits");
+        }
+        return config;
+    }
+
+    static void join_all(std::vector<std::thread>& threads) {
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        threads.clear();
+    }
+
+    std::int64_t now_ns() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_time).count();
+    }
+
+    SpscRing<SensorReading>& reading_ring(unsigned poller, unsigned aggregator) {
+        return *reading_rings[size_t{poller} * config.aggregators + aggregator];
+    }
+
+    // Pushes all n items, waiting while the ring is full
+    template <typename T>
+    static void push_all(SpscRing<T>& ring, const T* items, size_t n, Counter& counter) {
+        while (n > 0) {
+            size_t pushed = ring.try_push(items, n);
+            if (pushed == 0) {
+                counter.stalls.fetch_add(1, std::memory_order_relaxed);
+                std::this_thread::yield();
+            }
+            items += pushed;
+            n -= pushed;
+        }
+    }
+
+    void run_poller(unsigned p) {
+        Counter& counter = poll_counters[p];
+        size_t first = config.sensors * p / config.pollers;
+        size_t last = config.sensors * (p + 1) / config.pollers;
+        std::vector<TemperatureSensor> sensors;
+        for (size_t id = first; id < last; ++id) {
+            sensors.emplace_back(static_cast<int>(id));
+        }
+
+        std::vector<std::vector<SensorReading>> pending(config.aggregators);
+        for (auto& batch : pending) {
+            batch.reserve(config.batch_size);
+        }
+        auto flush = [&](unsigned a) {
+            push_all(reading_ring(p, a), pending[a].data(), pending[a].size(), counter);
+            counter.items.fetch_add(pending[a].size(), std::memory_order_relaxed);
+            pending[a].clear();
+        };
+
+        using clock = std::chrono::steady_clock;
+        auto period = config.poll_rate_hz > 0
+            ? std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / config.poll_rate_hz))
+            : clock::duration::zero();
+        auto next_round = clock::now();
+        while (running.load(std::memory_order_relaxed)) {
+            std::int64_t timestamp = now_ns();  // one timestamp per round
+            for (size_t i = 0; i < sensors.size(); ++i) {
+                auto id = static_cast<std::uint32_t>(first + i);
+                unsigned a = id % config.aggregators;
+                pending[a].push_back({id, sensors[i].readTemperature(), timestamp});
+                if (pending[a].size() == config.batch_size) {
+                    flush(a);
+                }
+            }
+            // Partial batches go out at the end of each round so a slow poll
+            // rate never holds readings back for longer than one period
+            for (unsigned a = 0; a < config.aggregators; ++a) {
+                if (!pending[a].empty()) {
+                    flush(a);
+                }
+            }
+            if (period != clock::duration::zero()) {
+                next_round += period;
+                std::this_thread::sleep_until(next_round);
+            }
+        }
+    }
+
+    void run_aggregator(unsigned a) {
+        Counter& counter = aggregate_counters[a];
+        // Sensor id = local index * aggregators + a
+        std::vector<SeriesStats> windows((config.sensors - a + config.aggregators - 1) / config.aggregators);
+        std::vector<SensorReading> batch(config.batch_size);
+        std::vector<SensorSummary> outgoing;
+        outgoing.reserve(config.batch_size);
+
+        auto publish = [&](std::int64_t window_end) {
+            for (size_t local = 0; local < windows.size(); ++local) {
+                if (windows[local].count == 0) {
+                    continue;
+                }
+                auto id = static_cast<std::uint32_t>(local * config.aggregators + a);
+                outgoing.push_back({id, window_end, windows[local]});
+                windows[local] = SeriesStats();
+                if (outgoing.size() == config.batch_size) {
+                    push_all(*summary_rings[a], outgoing.data(), outgoing.size(), counter);
+                    outgoing.clear();
+                }
+            }
+            push_all(*summary_rings[a], outgoing.data(), outgoing.size(), counter);
+            outgoing.clear();
+        };
+
+        auto next_publish = std::chrono::steady_clock::now() + config.publish_interval;
+        for (;;) {
+            // Read the flag before draining: if it was already set, an empty
+            // pass means no poller will ever push again
+            bool done = pollers_done.load(std::memory_order_acquire);
+            size_t received = 0;
+            // One batch per ring per pass keeps busy pollers from starving the rest
+            for (unsigned p = 0; p < config.pollers; ++p) {
+                size_t n = reading_ring(p, a).try_pop(batch.data(), batch.size());
+                for (size_t i = 0; i < n; ++i) {
+                    windows[batch[i].sensor / config.aggregators].add(batch[i].value);
+                }
+                received += n;
+            }
+            counter.items.fetch_add(received, std::memory_order_relaxed);
+
+            auto now = std::chrono::steady_clock::now();
+            if (now >= next_publish) {
+                publish(now_ns());
+                next_publish = now + config.publish_interval;
+            }
+            if (received == 0) {
+                if (done) {
+                    break;
+                }
+                std::this_thread::yield();
+            }
+        }
+        publish(now_ns());
+    }
+
+    void run_sink() {
+        std::vector<SensorSummary> batch(config.batch_size);
+        for (;;) {
+            bool done = aggregators_done.load(std::memory_order_acquire);
+            size_t received = 0;
+            for (auto& ring : summary_rings) {
+                size_t n = ring->try_pop(batch.data(), batch.size());
+                if (n == 0) {
+                    continue;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(results_mutex);
+                    for (size_t i = 0; i < n; ++i) {
+                        latest_results[batch[i].sensor] = batch[i];
+                    }
+                }
+                if (publisher) {
+                    for (size_t i = 0; i < n; ++i) {
+                        publisher(batch[i]);
+                    }
+                }
+                received += n;
+            }
+            sink_counter.items.fetch_add(received, std::memory_order_relaxed);
+            if (received == 0) {
+                if (done) {
+                    break;
+                }
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    IngestConfig config;
+    Publisher publisher;
+
+    std::vector<std::unique_ptr<SpscRing<SensorReading>>> reading_rings;  // [poller][aggregator]
+    std::vector<std::unique_ptr<SpscRing<SensorSummary>>> summary_rings;  // [aggregator]
+
+    std::vector<Counter> poll_counters;
+    std::vector<Counter> aggregate_counters;
+    Counter sink_counter;
+
+    mutable std::mutex results_mutex;
+    std::vector<SensorSummary> latest_results;
+
+    std::atomic<bool> running{false};
+    std::atomic<bool> pollers_done{false};
+    std::atomic<bool> aggregators_done{false};
+    bool started = false;
+    bool stopped = false;
+    std::chrono::steady_clock::time_point start_time;
+    std::chrono::steady_clock::time_point stop_time;
+
+    std::thread sink_thread;
+    std::vector<std::thread> aggregator_threads;
+    std::vector<std::thread> poller_threads;
+};
+
+#endif // INGEST_PIPELINE_HPP
@@ -4,19 +4,9 @@
 #include <algorithm>
 #include <cstring>
 #include <map>
-
-// Simulates a hardware temperature sensor
-class TemperatureSensor {
-public:
-    TemperatureSensor(int id) : sensorId(id) {}
-    
-    float readTemperature() const {
-        return 20.0f + (sensorId * 1.5f) + (rand() % 10) / 10.0f;
-    }
-    
-private:
-    int sensorId;
-};
+#include "temperature_sensor.hpp"
+#include "series_store.hpp"
+#include "data_logger.hpp"
 
 // Using raw pointers and manual memory management (C-style)
 void rawPointerExample(int numSensors, int numReadings) {
@@ -108,24 +98,7 @@ void smartPointerExample(int numSensors, int numReadings) {
         sensors.push_back(std::make_unique<TemperatureSensor>(i));
     }
     
-    // Create a DataLogger that will share ownership of temperature data
-    class DataLogger {
-    public:
-        void logReading(int sensorId, float reading) {
-            if (m_data.find(sensorId) == m_data.end()) {
-                m_data[sensorId] = std::make_shared<std::vector<float>>();
-            }
-            m_data[sensorId]->push_back(reading);
-        }
-        
-        std::shared_ptr<std::vector<float>> getReadings(int sensorId) {
-            return m_data[sensorId];
-        }
-        
-    private:
-        std::map<int, std::shared_ptr<std::vector<float>>> m_data;
-    };
-    
+    // DataLogger (data_logger.hpp) shares ownership of temperature data
     DataLogger logger;
     
     // Collect readings
@@ -156,7 +129,7 @@ void smartPointerExample(int numSensors, int numReadings) {
         }
         
     private:
-        std::shared_ptr<std::vector<float>> m_readings;
+        std::shared_ptr<const std::vector<float>> m_readings;
         int m_sensorId;
     };
     
@@ -171,6 +144,43 @@ void smartPointerExample(int numSensors, int numReadings) {
         analyzer.displayResult();
     }
     
+    // Live windows are maintained as readings arrive, so reading them is O(1)
+    for (int i = 0; i < numSensors; i++) {
+        const SlidingWindow& recent = logger.getWindows(i)->byCount;
+        std::cout << "Sensor " << i << " last " << recent.count() << " readings: mean "
+                  << recent.mean() << "°C, range " << recent.min() << " to " << recent.max() << "\n";
+    }
+    
+    // Percentiles come from mergeable sketches rather than sorting history
+    TDigest fleet = logger.fleetDigest();
+    std::cout << "All sensors p50: " << fleet.quantile(0.5) << "°C, p99: " << fleet.quantile(0.99) << "°C\n";
+    
+}
+
+// Using a column-oriented store with vectorized aggregation
+void columnarExample(int numSensors, int numReadings) {
+    std::cout << "\n--- Columnar Store Example ---\n";
+    
+    std::vector<TemperatureSensor> sensors;
+    for (int i = 0; i < numSensors; i++) {
+        sensors.emplace_back(i);
+    }
+    
+    SensorSeriesStore store(numSensors); // One timestamp and one value column per sensor
+    
+    // Collect readings
+    for (int j = 0; j < numReadings; j++) {
+        for (int i = 0; i < numSensors; i++) {
+            store.append(i, j, sensors[i].readTemperature());
+        }
+    }
+    
+    for (int i = 0; i < numSensors; i++) {
+        SeriesStats stats = store.stats(i);
+        std::cout << "Sensor " << i << " average: " << stats.mean() << "°C"
+                  << " (min " << stats.min << ", max " << stats.max
+                  << ", variance " << stats.variance() << ")\n";
+    }
 }
 
 int main() {
@@ -180,6 +190,7 @@ int main() {
     rawPointerExample(NUM_SENSORS, NUM_READINGS);
     raiiBased(NUM_SENSORS, NUM_READINGS);
     smartPointerExample(NUM_SENSORS, NUM_READINGS);
+    columnarExample(NUM_SENSORS, NUM_READINGS);
     
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,88 @@
+#ifndef PHILOX_HPP
+#define PHILOX_HPP
+
+#include <array>
+#include <cstdint>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PHILOX_HAVE_AVX2 1
+#include <immintrin.h>
+#endif
+
+// Philox4x32-10 counter-based random number generator (Salmon et al.,
+// SC 2011, the generator behind Random123 and cuRAND). Output is a pure
+// function of (counter, key): there is no state to share or lock, any
+// reading can be generated directly from its index, and eight counters can
+// go through the rounds side by side in AVX2 registers.
+namespace philox {
+
+using Counter = std::array<std::uint32_t, 4>;
+using Key = std::array<std::uint32_t, 2>;
+
+inline constexpr std::uint32_t multiplier0 = 0xD2511F53;
+inline constexpr std::uint32_t multiplier1 = 0xCD9E8D57;
+inline constexpr std::uint32_t weyl0 = 0x9E3779B9;  // golden ratio
+inline constexpr std::uint32_t weyl1 = 0xBB67AE85;  // sqrt(3) - 1
+inline constexpr int rounds = 10;
+
+[[nodiscard]] constexpr Key make_key(std::uint64_t seed) noexcept {
+    return {static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)};
+}
+
+[[nodiscard]] constexpr Counter block(Counter c, Key k) noexcept {
+    for (int r = 0; r < rounds; ++r) {
+        std::uint64_t p0 = std::uint64_t{multiplier0} * c[0];
+        std::uint64_t p1 = std::uint64_t{multiplier1} * c[2];
+        c = {static_cast<std::uint32_t>(p1 >> 32) ^ c[1] ^ k[0], static_cast<std::uint32_t>(p1),
+             static_cast<std::uint32_t>(p0 >> 32) ^ c[3] ^ k[1], static_cast<std::uint32_t>(p0)};
+        k[0] += weyl0;
+        k[1] += weyl1;
+    }
+    return c;
+}
+
+#ifdef PHILOX_HAVE_AVX2
+namespace detail {
+
+// Full 32x32 -> 64 products of eight lanes, split into low and high words
+__attribute__((target("avx2"))) inline void mulhilo(__m256i a, __m256i m, __m256i& lo, __m256i& hi) noexcept {
+    __m256i even = _mm256_mul_epu32(a, m);
+    __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);
+    lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+    hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+}
+
+} // namespace detail
+
+// Eight blocks at once: lane i of c[j] is word j of block i
+__attribute__((target("avx2"))) inline void block8(__m256i c[4], Key k) noexcept {
+    const __m256i m0 = _mm256_set1_epi32(static_cast<int>(multiplier0));
+    const __m256i m1 = _mm256_set1_epi32(static_cast<int>(multiplier1));
+    for (int r = 0; r < rounds; ++r) {
+        __m256i lo0, hi0, lo1, hi1;
+        detail::mulhilo(c[0], m0, lo0, hi0);
+        detail::mulhilo(c[2], m1, lo1, hi1);
+        __m256i k0 = _mm256_set1_epi32(static_cast<int>(k[0]));
+        __m256i k1 = _mm256_set1_epi32(static_cast<int>(k[1]));
+        c[0] = _mm256_xor_si256(_mm256_xor_si256(hi1, c[1]), k0);
+        c[1] = lo1;
+        c[2] = _mm256_xor_si256(_mm256_xor_si256(hi0, c[3]), k1);
+        c[3] = lo0;
+        k[0] += weyl0;
+        k[1] += weyl1;
+    }
+}
+#endif // PHILOX_HAVE_AVX2
+
+[[nodiscard]] inline bool avx2_available() noexcept {
+#ifdef PHILOX_HAVE_AVX2
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+} // namespace philox
+
+#endif // PHILOX_HPP
@@ -0,0 +1,466 @@
+#ifndef QUANTILE_SKETCH_HPP
+#define QUANTILE_SKETCH_HPP
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+// Fixed-memory quantile estimators. Both sketches merge losslessly with
+// other sketches of the same configuration, so per-sensor or per-thread
+// sketches can be combined into fleet-wide percentiles, and both serialize
+// to a few hundred bytes to a few KiB.
+//
+// TDigest: accuracy is relative to the rank, so the tails (p99.9) are much
+// tighter than the middle; memory is O(compression).
+// LogLinearHistogram: HDR-style buckets with a fixed relative error in
+// value over a configured range; updates are a shift and an increment.
+
+namespace sketch_detail {
+
+inline void put_varint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+template <typename T>
+void put_raw(std::vector<std::uint8_t>& out, T value) {
+    size_t at = out.size();
+    out.resize(at + sizeof(T));
+    std::memcpy(out.data() + at, &value, sizeof(T));
+}
+
+// Bounds-checked reader over a serialized sketch
+class Reader {
+public:
+    Reader(const std::uint8_t* data, size_t size) : data(data), end(data + size) {}
+
+    std::uint64_t varint() {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            std::uint8_t byte = next();
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        throw std::invalid_argument("Corrupt sketch: varint too long");
+    }
+
+    template <typename T>
+    T raw() {
+        if (static_cast<size_t>(end - data) < sizeof(T)) {
+            throw std::invalid_argument("Corrupt sketch: truncated");
+        }
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        data += sizeof(T);
+        return value;
+    }
+
+    std::uint8_t next() {
+        if (data == end) {
+            throw std::invalid_argument("Corrupt sketch: truncated");
+        }
+        return *data++;
+    }
+
+private:
+    const std::uint8_t* data;
+    const std::uint8_t* end;
+};
+
+} // namespace sketch_detail
+
+// Merging t-digest (Dunning & Ertl).
+// Readings are buffered and folded into the centroid list in sorted batches.
+class TDigest {
+public:
+    // Memory is linear in compression; past this it is a corrupt value
+    static constexpr double max_compression = 1e5;
+
+    explicit TDigest(double compression = 100.0)
+        : compression(checked_compression(compression)), buffer_limit(static_cast<size_t>(compression) * 5) {
+        centroids.reserve(static_cast<size_t>(compression) * 2);
+        buffer.reserve(buffer_limit);
+    }
+
+    void add(double value, double weight = 1.0) {
+        if (std::isnan(value)) {
+            return;
+        }
+        buffer.push_back({value, weight});
+        buffered_weight += weight;
+        min_value = std::min(min_value, value);
+        max_value = std::max(max_value, value);
+        if (buffer.size() >= buffer_limit) {
+            compress();
+        }
+    }
+
+    void merge(const TDigest& other) {
+        if (&other == this) {
+            return;
+        }
+        for (const Centroid& c : other.centroids) {
+            buffer.push_back(c);
+            buffered_weight += c.weight;
+        }
+        for (const Centroid& c : other.buffer) {
+            buffer.push_back(c);
+            buffered_weight += c.weight;
+        }
+        min_value = std::min(min_value, other.min_value);
+        max_value = std::max(max_value, other.max_value);
+        compress();
+    }
+
+    [[nodiscard]] double count() const noexcept {
+        return merged_weight + buffered_weight;
+    }
+
+    // Estimated value at rank q in [0, 1]; NaN when empty
+    [[nodiscard]] double quantile(double q) const {
+        compress();
+        if (centroids.empty()) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        q = std::clamp(q, 0.0, 1.0);
+        if (centroids.size() == 1) {
+            return centroids.front().mean;
+        }
+        double target = q * merged_weight;
+
+        // Below the first centroid's centre: interpolate from the minimum
+        const Centroid& first = centroids.front();
+        if (target < first.weight / 2) {
+            if (first.weight == 1) {
+                return min_value;
+            }
+            return min_value + (first.mean - min_value) * (target / (first.weight / 2));
+        }
+        const Centroid& last = centroids.back();
+        if (target > merged_weight - last.weight / 2) {
+            if (last.weight == 1) {
+                return max_value;
+            }
+            double into = target - (merged_weight - last.weight / 2);
+            return last.mean + (max_value - last.mean) * (into / (last.weight / 2));
+        }
+        // Between centroid centres: linear in rank
+        double centre = first.weight / 2;
+        for (size_t i = 0; i + 1 < centroids.size(); ++i) {
+            double gap = (centroids[i].weight + centroids[i + 1].weight) / 2;
+            if (target <= centre + gap) {
+                double t = gap > 0 ? (target - centre) / gap : 0.0;
+                return centroids[i].mean + t * (centroids[i + 1].mean - centroids[i].mean);
+            }
+            centre += gap;
+        }
+        return last.mean;
+    }
+
+    [[nodiscard]] double min() const noexcept { return min_value; }
+    [[nodiscard]] double max() const noexcept { return max_value; }
+
+    [[nodiscard]] size_t centroid_count() const {
+        compress();
+        return centroids.size();
+    }
+
+    // Layout: compression, min, max (doubles), centroid count (varint), then
+    // per centroid a double mean and a tagged varint: weight << 1 for a
+    // whole weight, or 1 followed by the weight as a double. Centroids
+    // round-trip exactly.
+    [[nodiscard]] std::vector<std::uint8_t> serialize() const {
+        compress();
+        std::vector<std::uint8_t> out;
+        out.reserve(32 + centroids.size() * 10);
+        sketch_detail::put_raw(out, compression);
+        sketch_detail::put_raw(out, min_value);
+        sketch_detail::put_raw(out, max_value);
+        sketch_detail::put_varint(out, centroids.size());
+        for (const Centroid& c : centroids) {
+            sketch_detail::put_raw(out, c.mean);
+            if (c.weight == std::floor(c.weight) && c.weight < 0x1p62) {
+                sketch_detail::put_varint(out, static_cast<std::uint64_t>(c.weight) << 1);
+            } else {
+                sketch_detail::put_varint(out, 1);
+                sketch_detail::put_raw(out, c.weight);
+            }
+        }
+        return out;
+    }
+
+    static TDigest deserialize(const std::uint8_t* data, size_t size) {
+        sketch_detail::Reader in(data, size);
+        auto compression = in.raw<double>();
+        if (!(compression >= 10.0 && compression <= max_compression)) {
+            throw std::invalid_argument("Corrupt sketch: compression");
+        }
+        TDigest digest(compression);
+        digest.min_value = in.raw<double>();
+        digest.max_value = in.raw<double>();
+        std::uint64_t n = in.varint();
+        if (n > size) {
+            throw std::invalid_argument("Corrupt sketch: centroid count");
+        }
+        for (std::uint64_t i = 0; i < n; ++i) {
+            auto mean = in.raw<double>();
+            std::uint64_t tagged = in.varint();
+            double weight = tagged & 1 ? in.raw<double>() : static_cast<double>(tagged >> 1);
+            if (std::isnan(mean) || !(weight >= 0.0 && weight < std::numeric_limits<double>::infinity())) {
+                throw std::invalid_argument("Corrupt sketch: centroid");
+            }
+            digest.centroids.push_back({mean, weight});
+            digest.merged_weight += weight;
+        }
+        return digest;
+    }
+
+private:
+    // Runs before the sizes derived from compression are computed
+    static double checked_compression(double compression) {
+        if (!(compression >= 10.0 && compression <= max_compression)) {
+            throw std::invalid_argument("TDigest compression must be between 10 and 1e5");
+        }
+        return compression;
+    }
+
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    // Log-odds scale function (k2 in Dunning & Ertl). Centroid size shrinks
+    // in proportion to q(1 - q), so the extreme tails stay near singletons.
+    // normalizer depends on the total weight being compressed.
+    double k_scale(double q, double normalizer) const noexcept {
+        if (q <= 0.0) {
+            return -std::numeric_limits<double>::infinity();
+        }
+        if (q >= 1.0) {
+            return std::numeric_limits<double>::infinity();
+        }
+        return compression / normalizer * std::log(q / (1 - q));
+    }
+
+    double k_inverse(double k, double normalizer) const noexcept {
+        return 1 / (1 + std::exp(-k * normalizer / compression));
+    }
+
+    // Folds the buffer into the centroids. Logically const: the estimate
+    // does not change, only its representation.
+    void compress() const {
+        if (buffer.empty()) {
+            return;
+        }
+        // Centroids are already in order; only the new points need sorting
+        auto by_mean = [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; };
+        std::sort(buffer.begin(), buffer.end(), by_mean);
+        size_t fresh = buffer.size();
+        buffer.insert(buffer.end(), centroids.begin(), centroids.end());
+        std::inplace_merge(buffer.begin(), buffer.begin() + fresh, buffer.end(), by_mean);
+        double total = merged_weight + buffered_weight;
+        double normalizer = 4 * std::log(std::max(total / compression, 1.0)) + 24;
+        centroids.clear();
+
+        Centroid current = buffer.front();
+        double weight_before = 0.0;
+        double q_limit = k_inverse(k_scale(0.0, normalizer) + 1, normalizer);
+        for (size_t i = 1; i < buffer.size(); ++i) {
+            const Centroid& next = buffer[i];
+            double q = (weight_before + current.weight + next.weight) / total;
+            if (q <= q_limit) {
+                current.weight += next.weight;
+                current.mean += (next.mean - current.mean) * next.weight / current.weight;
+            } else {
+                weight_before += current.weight;
+                centroids.push_back(current);
+                q_limit = k_inverse(k_scale(weight_before / total, normalizer) + 1, normalizer);
+                current = next;
+            }
+        }
+        centroids.push_back(current);
+        merged_weight = total;
+        buffered_weight = 0.0;
+        buffer.clear();
+    }
+
+    double compression;
+    size_t buffer_limit;
+    mutable std::vector<Centroid> centroids;
+    mutable std::vector<Centroid> buffer;
+    mutable double merged_weight = 0.0;
+    mutable double buffered_weight = 0.0;
+    double min_value = std::numeric_limits<double>::infinity();
+    double max_value = -std::numeric_limits<double>::infinity();
+};
+
+// Log-linear histogram over floats, after HdrHistogram. Each power-of-two
+// range of |value| between 2^min_exponent and 2^max_exponent is split into
+// 2^sub_bucket_bits equal buckets, which bounds the relative error of any
+// quantile by 2^-sub_bucket_bits. Smaller magnitudes share one zero bucket;
+// larger ones are clamped to the top bucket. Negative values are mirrored.
+class LogLinearHistogram {
+public:
+    explicit LogLinearHistogram(int sub_bucket_bits = 6, int min_exponent = -8, int max_exponent = 16)
+        : sub_bits(sub_bucket_bits), min_exp(min_exponent), max_exp(max_exponent) {
+        if (sub_bits < 1 || sub_bits > 16 || min_exp >= max_exp || min_exp < -126 || max_exp > 127) {
+            throw std::invalid_argument("LogLinearHistogram configuration out of range");
+        }
+        buckets_per_sign = static_cast<size_t>(max_exp - min_exp) << sub_bits;
+        counts.assign(2 * buckets_per_sign + 1, 0);
+    }
+
+    void add(float value, std::uint64_t times = 1) noexcept {
+        if (std::isnan(value)) {
+            return;
+        }
+        counts[index_of(value)] += times;
+        total += times;
+        min_value = std::min(min_value, value);
+        max_value = std::max(max_value, value);
+    }
+
+    // Both histograms must have the same configuration
+    void merge(const LogLinearHistogram& other) {
+        if (!same_layout(other)) {
+            throw std::invalid_argument("LogLinearHistogram layouts differ");
+        }
+        for (size_t i = 0; i < counts.size(); ++i) {
+            counts[i] += other.counts[i];
+        }
+        total += other.total;
+        min_value = std::min(min_value, other.min_value);
+        max_value = std::max(max_value, other.max_value);
+    }
+
+    [[nodiscard]] std::uint64_t count() const noexcept { return total; }
+    [[nodiscard]] float min() const noexcept { return min_value; }
+    [[nodiscard]] float max() const noexcept { return max_value; }
+
+    // Midpoint of the bucket holding rank q, clamped to the observed range
+    [[nodiscard]] double quantile(double q) const noexcept {
+        if (total == 0) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        q = std::clamp(q, 0.0, 1.0);
+        auto rank = static_cast<std::uint64_t>(std::ceil(q * total));
+        rank = std::max<std::uint64_t>(rank, 1);
+        std::uint64_t seen = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                return std::clamp(midpoint_of(i), static_cast<double>(min_value), static_cast<double>(max_value));
+            }
+        }
+        return max_value;
+    }
+
+    // Layout: the three configuration ints, min, max, the number of
+    // non-empty buckets, then a (zero run, count) varint pair for each
+    [[nodiscard]] std::vector<std::uint8_t> serialize() const {
+        std::vector<std::uint8_t> out;
+        sketch_detail::put_raw(out, static_cast<std::int8_t>(sub_bits));
+        sketch_detail::put_raw(out, static_cast<std::int8_t>(min_exp));
+        sketch_detail::put_raw(out, static_cast<std::int8_t>(max_exp));
+        sketch_detail::put_raw(out, min_value);
+        sketch_detail::put_raw(out, max_value);
+        sketch_detail::put_varint(out, static_cast<std::uint64_t>(
+            std::count_if(counts.begin(), counts.end(), [](std::uint64_t c) { return c != 0; })));
+        size_t zeros = 0;
+        for (std::uint64_t c : counts) {
+            if (c == 0) {
+                ++zeros;
+                continue;
+            }
+            sketch_detail::put_varint(out, zeros);
+            sketch_detail::put_varint(out, c);
+            zeros = 0;
+        }
+        return out;
+    }
+
+    static LogLinearHistogram deserialize(const std::uint8_t* data, size_t size) {
+        sketch_detail::Reader in(data, size);
+        int sub = in.raw<std::int8_t>();
+        int lo = in.raw<std::int8_t>();
+        int hi = in.raw<std::int8_t>();
+        LogLinearHistogram histogram(sub, lo, hi);
+        histogram.min_value = in.raw<float>();
+        histogram.max_value = in.raw<float>();
+        std::uint64_t non_empty = in.varint();
+        size_t index = 0;
+        for (std::uint64_t i = 0; i < non_empty; ++i) {
+            index += in.varint();
+            if (index >= histogram.counts.size()) {
+                throw std::invalid_argument("Corrupt sketch: bucket index");
+            }
+            std::uint64_t c = in.varint();
+            histogram.counts[index++] = c;
+            histogram.total += c;
+        }
+        return histogram;
+    }
+
+private:
+    bool same_layout(const LogLinearHistogram& other) const noexcept {
+        return sub_bits == other.sub_bits && min_exp == other.min_exp && max_exp == other.max_exp;
+    }
+
+    // Index 0..n-1 negative (most negative first), n zero, n+1.. positive
+    size_t index_of(float value) const noexcept {
+        size_t magnitude = magnitude_index(std::fabs(value));
+        if (magnitude == 0) {
+            return buckets_per_sign;
+        }
+        return value < 0 ? buckets_per_sign - magnitude : buckets_per_sign + magnitude;
+    }
+
+    // 0 for the zero bucket, else 1 + exponent-major, mantissa-minor index
+    size_t magnitude_index(float magnitude) const noexcept {
+        int exponent;
+        float fraction = std::frexp(magnitude, &exponent);  // magnitude = fraction * 2^exponent, fraction in [0.5, 1)
+        --exponent;  // now magnitude = (2 * fraction) * 2^exponent with 2 * fraction in [1, 2)
+        if (magnitude == 0.0f || exponent < min_exp) {
+            return 0;
+        }
+        if (!std::isfinite(magnitude) || exponent >= max_exp) {
+            return buckets_per_sign;  // overflow bucket, infinities included
+        }
+        auto sub = static_cast<size_t>((2 * fraction - 1) * (1 << sub_bits));
+        return 1 + (static_cast<size_t>(exponent - min_exp) << sub_bits) + sub;
+    }
+
+    double midpoint_of(size_t index) const noexcept {
+        if (index == buckets_per_sign) {
+            return 0.0;
+        }
+        bool negative = index < buckets_per_sign;
+        size_t magnitude = negative ? buckets_per_sign - index : index - buckets_per_sign;
+        size_t offset = magnitude - 1;
+        int exponent = static_cast<int>(offset >> sub_bits) + min_exp;
+        double sub = static_cast<double>(offset & ((size_t{1} << sub_bits) - 1));
+        double value = std::ldexp(1.0 + (sub + 0.5) / (1 << sub_bits), exponent);
+        return negative ? -value : value;
+    }
+
+    int sub_bits;
+    int min_exp;
+    int max_exp;
+    size_t buckets_per_sign;
+    std::vector<std::uint64_t> counts;
+    std::uint64_t total = 0;
+    float min_value = std::numeric_limits<float>::infinity();
+    float max_value = -std::numeric_limits<float>::infinity();
+};
+
+#endif // QUANTILE_SKETCH_HPP
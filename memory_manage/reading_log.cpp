@@ -0,0 +1,553 @@
+// reading_log.cpp
+#include "reading_log.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char segment_magic[8] = {'R', 'L', 'O', 'G', 'S', 'E', 'G', '1'};
+constexpr char footer_magic[8] = {'R', 'L', 'O', 'G', 'F', 'T', 'R', '1'};
+constexpr std::uint32_t batch_magic = 0x48435442;  // "BTCH"
+constexpr std::uint32_t format_version = 1;
+
+struct SegmentHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t record_bytes;
+    std::uint64_t sequence;
+    std::uint64_t file_bytes;
+    std::byte reserved[32];
+};
+static_assert(sizeof(SegmentHeader) == 64);
+
+struct BatchHeader {
+    std::uint32_t magic;
+    std::uint32_t count;
+    std::uint32_t crc;  // CRC-32C of the records, seeded with count
+    std::uint32_t epoch;  // never decreases along a segment; 0 in older files
+};
+static_assert(sizeof(BatchHeader) == 16);
+
+struct SegmentFooter {
+    char magic[8];
+    std::uint64_t records;
+    std::uint64_t batches;
+    std::uint64_t data_end;
+    std::int64_t min_timestamp;
+    std::int64_t max_timestamp;
+    std::uint32_t crc;  // CRC-32C of the footer bytes before this field
+    std::byte reserved[12];
+};
+static_assert(sizeof(SegmentFooter) == 64);
+
+[[noreturn]] void throw_errno(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+// CRC-32C (Castagnoli), with the SSE4.2 instruction when available
+constexpr std::array<std::uint32_t, 256> make_crc_table() {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1) ? (c >> 1) ^ 0x82F63B78u : c >> 1;
+        }
+        table[i] = c;
+    }
+    return table;
+}
+
+constexpr auto crc_table = make_crc_table();
+
+std::uint32_t crc32c_portable(std::uint32_t crc, const std::byte* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        crc = crc_table[(crc ^ static_cast<std::uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#if defined(__GNUC__) && defined(__x86_64__)
+__attribute__((target("sse4.2"))) std::uint32_t crc32c_sse42(std::uint32_t crc, const std::byte* data, size_t size) {
+    std::uint64_t c = crc;
+    for (; size >= 8; data += 8, size -= 8) {
+        std::uint64_t word;
+        std::memcpy(&word, data, 8);
+        c = __builtin_ia32_crc32di(c, word);
+    }
+    auto c32 = static_cast<std::uint32_t>(c);
+    for (; size > 0; ++data, --size) {
+        c32 = __builtin_ia32_crc32qi(c32, static_cast<unsigned char>(*data));
+    }
+    return c32;
+}
+#endif
+
+std::uint32_t crc32c(const void* data, size_t size, std::uint32_t seed = 0) {
+    auto bytes = static_cast<const std::byte*>(data);
+    std::uint32_t crc = ~seed;
+#if defined(__GNUC__) && defined(__x86_64__)
+    static const bool hardware = __builtin_cpu_supports("sse4.2");
+    if (hardware) {
+        return ~crc32c_sse42(crc, bytes, size);
+    }
+#endif
+    return ~crc32c_portable(crc, bytes, size);
+}
+
+std::uint32_t footer_crc(const SegmentFooter& footer) {
+    return crc32c(&footer, offsetof(SegmentFooter, crc));
+}
+
+std::string segment_path(const std::string& directory, std::uint64_t sequence) {
+    char name[40];
+    std::snprintf(name, sizeof name, "segment-%016llu.log", static_cast<unsigned long long>(sequence));
+    return directory + "/" + name;
+}
+
+bool read_exact(int fd, void* out, size_t size, off_t offset) {
+    auto* dest = static_cast<std::byte*>(out);
+    while (size > 0) {
+        ssize_t n = ::pread(fd, dest, size, offset);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        dest += n;
+        size -= static_cast<size_t>(n);
+        offset += n;
+    }
+    return true;
+}
+
+void write_footer(std::byte* base, std::uint64_t file_bytes, const SegmentInfo& info) {
+    SegmentFooter footer{};
+    std::memcpy(footer.magic, footer_magic, sizeof footer_magic);
+    footer.records = info.records;
+    footer.batches = info.batches;
+    footer.data_end = info.data_end;
+    footer.min_timestamp = info.min_timestamp;
+    footer.max_timestamp = info.max_timestamp;
+    footer.crc = footer_crc(footer);
+    std::memcpy(base + file_bytes - sizeof(SegmentFooter), &footer, sizeof footer);
+}
+
+void note_timestamps(SegmentInfo& info, const LogRecord* records, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        if (info.records == 0 && i == 0) {
+            info.min_timestamp = info.max_timestamp = records[0].timestamp;
+        }
+        info.min_timestamp = std::min(info.min_timestamp, records[i].timestamp);
+        info.max_timestamp = std::max(info.max_timestamp, records[i].timestamp);
+    }
+}
+
+// Mapping of a whole segment file, for recovery and scans
+class MappedFile {
+public:
+    MappedFile(const std::string& path, bool writable) {
+        fd = ::open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+        if (fd < 0) {
+            throw_errno("open " + path);
+        }
+        off_t end = ::lseek(fd, 0, SEEK_END);
+        if (end < 0) {
+            ::close(fd);
+            throw_errno("lseek " + path);
+        }
+        size = static_cast<size_t>(end);
+        void* p = ::mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            throw_errno("mmap " + path);
+        }
+        base = static_cast<std::byte*>(p);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        ::munmap(base, size);
+        ::close(fd);
+    }
+
+    std::byte* base = nullptr;
+    size_t size = 0;
+    int fd = -1;
+};
+
+} // namespace
+
+ReadingLog::ReadingLog(ReadingLogConfig cfg) : config(std::move(cfg)) {
+    size_t min_bytes = sizeof(SegmentHeader) + sizeof(SegmentFooter) + sizeof(BatchHeader) + sizeof(LogRecord);
+    if (config.segment_bytes < min_bytes || config.batch_records == 0) {
+        throw std::invalid_argument("ReadingLogConfig segment_bytes or batch_records too small");
+    }
+    // Whole pages, so records stay 16-byte aligned and the footer ends the last page
+    config.segment_bytes = (config.segment_bytes + 4095) & ~size_t{4095};
+    std::filesystem::create_directories(config.directory);
+    pending.reserve(config.batch_records);
+    recover();
+}
+
+ReadingLog::~ReadingLog() {
+    try {
+        sync();
+    } catch (...) {
+        // Nothing useful to do in a destructor; recovery handles the tail
+    }
+    unmap_active();
+}
+
+void ReadingLog::recover() {
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::pair<std::uint64_t, std::string>> files;
+    for (const auto& entry : std::filesystem::directory_iterator(config.directory)) {
+        unsigned long long sequence;
+        std::string name = entry.path().filename().string();
+        if (std::sscanf(name.c_str(), "segment-%16llu.log", &sequence) == 1) {
+            files.emplace_back(sequence, entry.path().string());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    for (size_t f = 0; f < files.size(); ++f) {
+        const auto& [sequence, path] = files[f];
+        next_sequence = sequence + 1;  // never reuse a name, even of a skipped file
+        SegmentInfo info;
+        info.sequence = sequence;
+        info.path = path;
+
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw_errno("open " + path);
+        }
+        SegmentHeader header{};
+        SegmentFooter footer{};
+        off_t file_end = ::lseek(fd, 0, SEEK_END);
+        bool header_ok = file_end >= static_cast<off_t>(sizeof header + sizeof footer) &&
+                         read_exact(fd, &header, sizeof header, 0) &&
+                         std::memcmp(header.magic, segment_magic, sizeof segment_magic) == 0 &&
+                         header.version == format_version &&
+                         header.file_bytes == static_cast<std::uint64_t>(file_end);
+        bool footer_ok = header_ok &&
+                         read_exact(fd, &footer, sizeof footer, file_end - static_cast<off_t>(sizeof footer)) &&
+                         std::memcmp(footer.magic, footer_magic, sizeof footer_magic) == 0 &&
+                         footer.crc == footer_crc(footer);
+        ::close(fd);
+        if (!header_ok) {
+            continue;  // not ours, or cut short while being created
+        }
+        info.file_bytes = static_cast<std::uint64_t>(file_end);
+        ++recovered.segments;
+        if (footer_ok) {
+            ++recovered.footers_read;
+            info.records = footer.records;
+            info.batches = footer.batches;
+            info.data_end = footer.data_end;
+            info.min_timestamp = footer.min_timestamp;
+            info.max_timestamp = footer.max_timestamp;
+            info.sealed = true;
+        } else {
+            MappedFile file(path, true);
+            scan_unsealed(info, file.base, file.size);
+            // Only the newest segment may stay open for appends; an older
+            // unsealed one (a crash mid-roll) gets its footer now
+            if (f + 1 < files.size()) {
+                write_footer(file.base, file.size, info);
+                if (::msync(file.base, file.size, MS_SYNC) != 0) {
+                    throw_errno("msync " + path);
+                }
+                info.sealed = true;
+            }
+        }
+        index.push_back(std::move(info));
+    }
+
+    if (index.empty() || index.back().sealed) {
+        open_new_segment();
+    } else {
+        map_active(index.back(), false);
+    }
+    apply_retention();
+
+    recovered.milliseconds = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+void ReadingLog::scan_unsealed(SegmentInfo& info, const std::byte* base, size_t file_bytes) {
+    std::uint64_t offset = sizeof(SegmentHeader);
+    std::uint64_t limit = file_bytes - sizeof(SegmentFooter);
+    while (offset + sizeof(BatchHeader) <= limit) {
+        BatchHeader batch;
+        std::memcpy(&batch, base + offset, sizeof batch);
+        std::uint64_t bytes = std::uint64_t{batch.count} * sizeof(LogRecord);
+        if (batch.magic != batch_magic || batch.count == 0 || offset + sizeof batch + bytes > limit ||
+            batch.epoch < info.epoch) {
+            break;  // an older epoch here was left past an earlier tear
+        }
+        const std::byte* payload = base + offset + sizeof batch;
+        if (crc32c(payload, bytes, batch.count) != batch.crc) {
+            break;  // torn write: everything from here on is discarded
+        }
+        note_timestamps(info, reinterpret_cast<const LogRecord*>(payload), batch.count);
+        info.epoch = batch.epoch;
+        info.records += batch.count;
+        ++info.batches;
+        ++recovered.batches_scanned;
+        offset += sizeof batch + bytes;
+    }
+    info.data_end = offset;
+}
+
+void ReadingLog::open_new_segment() {
+    SegmentInfo info;
+    info.sequence = next_sequence++;
+    info.path = segment_path(config.directory, info.sequence);
+    info.data_end = sizeof(SegmentHeader);
+    info.file_bytes = config.segment_bytes;
+    // Listed only once mapped, so a failed open leaves the index as it was
+    map_active(info, true);
+    index.push_back(std::move(info));
+}
+
+void ReadingLog::map_active(const SegmentInfo& info, bool fresh) {
+    int fd = ::open(info.path.c_str(), fresh ? O_RDWR | O_CREAT | O_EXCL : O_RDWR, 0644);
+    if (fd < 0) {
+        throw_errno("open " + info.path);
+    }
+    // A fresh file that could not be set up is removed again
+    auto fail = [&](int err, const std::string& what) {
+        ::close(fd);
+        if (fresh) {
+            ::unlink(info.path.c_str());
+        }
+        errno = err;
+        throw_errno(what + " " + info.path);
+    };
+    size_t file_bytes = config.segment_bytes;
+    if (fresh) {
+        // Reserve the blocks up front so appends never hit ENOSPC via SIGBUS
+        int err = ::posix_fallocate(fd, 0, static_cast<off_t>(file_bytes));
+        if (err == EINVAL || err == EOPNOTSUPP) {
+            err = ::ftruncate(fd, static_cast<off_t>(file_bytes)) == 0 ? 0 : errno;
+        }
+        if (err != 0) {
+            fail(err, "preallocate");
+        }
+    } else {
+        file_bytes = static_cast<size_t>(::lseek(fd, 0, SEEK_END));  // may predate a config change
+    }
+    void* p = ::mmap(nullptr, file_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        fail(errno, "mmap");
+    }
+    active_fd = fd;
+    active_base = static_cast<std::byte*>(p);
+    active_bytes = file_bytes;
+    if (fresh) {
+        SegmentHeader header{};
+        std::memcpy(header.magic, segment_magic, sizeof segment_magic);
+        header.version = format_version;
+        header.record_bytes = sizeof(LogRecord);
+        header.sequence = info.sequence;
+        header.file_bytes = file_bytes;
+        std::memcpy(active_base, &header, sizeof header);
+    }
+    synced_to = fresh ? 0 : info.data_end;
+    // Batches written from here on outrank anything after data_end
+    active_epoch = fresh ? 0 : info.epoch + 1;
+}
+
+void ReadingLog::append(const LogRecord& record) {
+    pending.push_back(record);
+    if (pending.size() >= config.batch_records) {
+        flush();
+    }
+}
+
+void ReadingLog::append(const LogRecord* records, size_t count) {
+    flush();
+    while (count > 0) {
+        size_t n = std::min(count, config.batch_records);
+        write_batch(records, n);
+        records += n;
+        count -= n;
+    }
+}
+
+void ReadingLog::flush() {
+    if (!pending.empty()) {
+        write_batch(pending.data(), pending.size());
+        pending.clear();
+    }
+}
+
+void ReadingLog::write_batch(const LogRecord* records, size_t count) {
+    while (count > 0) {
+        if (!active_base) {
+            // An earlier roll sealed the last segment but could not open
+            // the next one; retry, and throw again if it still fails
+            open_new_segment();
+        }
+        SegmentInfo& active = index.back();
+        std::uint64_t limit = active_bytes - sizeof(SegmentFooter);
+        std::uint64_t room = active.data_end + sizeof(BatchHeader) < limit
+            ? (limit - active.data_end - sizeof(BatchHeader)) / sizeof(LogRecord)
+            : 0;
+        if (room == 0) {
+            seal_active();
+            open_new_segment();
+            apply_retention();
+            continue;
+        }
+        auto n = static_cast<std::uint32_t>(std::min<std::uint64_t>(count, room));
+        std::uint64_t bytes = std::uint64_t{n} * sizeof(LogRecord);
+        std::byte* payload = active_base + active.data_end + sizeof(BatchHeader);
+        std::memcpy(payload, records, bytes);
+        BatchHeader header{batch_magic, n, crc32c(payload, bytes, n), active_epoch};
+        std::memcpy(active_base + active.data_end, &header, sizeof header);
+
+        note_timestamps(active, records, n);
+        active.epoch = active_epoch;
+        active.records += n;
+        ++active.batches;
+        active.data_end += sizeof header + bytes;
+        records += n;
+        count -= n;
+
+        if (config.sync_every_bytes && active.data_end - synced_to >= config.sync_every_bytes) {
+            sync_range(synced_to, active.data_end);
+        }
+    }
+}
+
+void ReadingLog::sync_range(std::uint64_t from, std::uint64_t to) {
+    std::uint64_t page = static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+    std::uint64_t start = from & ~(page - 1);
+    if (to > start && ::msync(active_base + start, to - start, MS_SYNC) != 0) {
+        throw_errno("msync " + index.back().path);
+    }
+    synced_to = to;
+}
+
+void ReadingLog::sync() {
+    flush();
+    if (active_base) {
+        sync_range(synced_to, index.back().data_end);
+    }
+}
+
+void ReadingLog::roll() {
+    flush();
+    if (active_base) {
+        seal_active();
+    }
+    open_new_segment();
+    apply_retention();
+}
+
+void ReadingLog::seal_active() {
+    SegmentInfo& active = index.back();
+    write_footer(active_base, active_bytes, active);
+    if (::msync(active_base, active_bytes, MS_SYNC) != 0) {
+        throw_errno("msync " + active.path);
+    }
+    active.sealed = true;
+    unmap_active();
+}
+
+void ReadingLog::unmap_active() noexcept {
+    if (active_base) {
+        ::munmap(active_base, active_bytes);
+        active_base = nullptr;
+    }
+    if (active_fd >= 0) {
+        ::close(active_fd);
+        active_fd = -1;
+    }
+}
+
+void ReadingLog::apply_retention() {
+    const RetentionPolicy& policy = config.retention;
+    std::int64_t newest = std::numeric_limits<std::int64_t>::min();
+    for (const auto& info : index) {
+        if (info.records > 0) {
+            newest = std::max(newest, info.max_timestamp);
+        }
+    }
+    auto over_limit = [&] {
+        const SegmentInfo& oldest = index.front();
+        if (policy.max_segments && index.size() > policy.max_segments) {
+            return true;
+        }
+        if (policy.max_bytes && bytes_on_disk() > policy.max_bytes) {
+            return true;
+        }
+        return policy.max_age && oldest.records > 0 && oldest.max_timestamp < newest - policy.max_age;
+    };
+    // The active segment is always the last entry and is never dropped
+    while (index.size() > 1 && over_limit()) {
+        std::filesystem::remove(index.front().path);
+        index.erase(index.begin());
+    }
+}
+
+void ReadingLog::scan(std::int64_t from, std::int64_t to, const std::function<void(const LogRecord&)>& visit) {
+    flush();
+    auto visit_batches = [&](const std::byte* base, const SegmentInfo& info) {
+        std::uint64_t offset = sizeof(SegmentHeader);
+        for (std::uint64_t b = 0; b < info.batches && offset < info.data_end; ++b) {
+            BatchHeader header;
+            std::memcpy(&header, base + offset, sizeof header);
+            auto* records = reinterpret_cast<const LogRecord*>(base + offset + sizeof header);
+            for (std::uint32_t i = 0; i < header.count; ++i) {
+                if (records[i].timestamp >= from && records[i].timestamp < to) {
+                    visit(records[i]);
+                }
+            }
+            offset += sizeof header + std::uint64_t{header.count} * sizeof(LogRecord);
+        }
+    };
+    for (const auto& info : index) {
+        if (info.records == 0 || info.max_timestamp < from || info.min_timestamp >= to) {
+            continue;
+        }
+        if (!info.sealed) {
+            visit_batches(active_base, info);
+        } else {
+            MappedFile file(info.path, false);
+            visit_batches(file.base, info);
+        }
+    }
+}
+
+std::uint64_t ReadingLog::record_count() const noexcept {
+    std::uint64_t total = pending.size();
+    for (const auto& info : index) {
+        total += info.records;
+    }
+    return total;
+}
+
+std::uint64_t ReadingLog::bytes_on_disk() const noexcept {
+    std::uint64_t total = 0;
+    for (const auto& info : index) {
+        total += info.file_bytes;
+    }
+    return total;
+}
@@ -0,0 +1,131 @@
+#ifndef READING_LOG_HPP
+#define READING_LOG_HPP
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+// Durable, append-only log of sensor readings (POSIX only).
+//
+// Readings go into preallocated segment files that stay memory-mapped while
+// they are being written, so an append is a memcpy into the page cache.
+// Records are written in checksummed batches, and msync runs every
+// sync_every_bytes (or on sync()), which bounds how much a crash can lose.
+//
+// A full segment is sealed with a footer recording its record count and
+// time range. Opening a log reads only the header and footer of each sealed
+// segment; the one unsealed segment left by a crash is recovered by
+// hopping from batch header to batch header and stopping at the first
+// batch whose checksum fails. Reopening an unsealed segment bumps its
+// epoch, which every batch header carries, so after a second crash the
+// scan also stops at an old batch left behind past the first tear.
+//
+// Segment layout:
+//     [SegmentHeader 64 B][BatchHeader 16 B][records ...][BatchHeader]...[SegmentFooter 64 B]
+//
+// One ReadingLog instance per directory, used from one thread at a time.
+
+struct LogRecord {
+    std::uint32_t sensor_id;
+    float value;
+    std::int64_t timestamp;
+};
+static_assert(sizeof(LogRecord) == 16, "LogRecord is written to disk as-is");
+
+// Limits on what is kept; 0 means unlimited. The active segment is never
+// removed.
+struct RetentionPolicy {
+    size_t max_segments = 0;
+    std::uint64_t max_bytes = 0;
+    std::int64_t max_age = 0;  // drop segments entirely older than newest timestamp - max_age
+};
+
+struct ReadingLogConfig {
+    std::string directory;
+    size_t segment_bytes = size_t{64} << 20;
+    size_t batch_records = 512;                 // records per checksummed batch for append(record)
+    size_t sync_every_bytes = size_t{8} << 20;  // 0: only on sync(), seal and close
+    RetentionPolicy retention;
+};
+
+struct SegmentInfo {
+    std::uint64_t sequence = 0;
+    std::string path;
+    std::uint64_t records = 0;
+    std::uint64_t batches = 0;
+    std::uint64_t data_end = 0;  // byte offset just past the last batch
+    std::uint64_t file_bytes = 0;  // preallocated size, footer at the end
+    std::int64_t min_timestamp = 0;
+    std::int64_t max_timestamp = 0;
+    std::uint32_t epoch = 0;  // of the newest batch; unsealed segments only
+    bool sealed = false;
+};
+
+struct RecoveryStats {
+    size_t segments = 0;
+    size_t footers_read = 0;
+    size_t batches_scanned = 0;  // in unsealed segments
+    double milliseconds = 0.0;
+};
+
+class ReadingLog {
+public:
+    // Opens (creating if needed) the log in config.directory and recovers it
+    explicit ReadingLog(ReadingLogConfig config);
+    ~ReadingLog();
+
+    ReadingLog(const ReadingLog&) = delete;
+    ReadingLog& operator=(const ReadingLog&) = delete;
+
+    // Buffers the record; a full buffer is written as one batch
+    void append(const LogRecord& record);
+
+    // Writes the records straight into the segment in batches of up to
+    // batch_records, after any buffered ones
+    void append(const LogRecord* records, size_t count);
+
+    // Writes buffered records to the mapped segment
+    void flush();
+
+    // flush() and msync everything written so far
+    void sync();
+
+    // Seals the active segment and starts a new one
+    void roll();
+
+    // Calls visit for every record with from <= timestamp < to, oldest
+    // segment first. Segments whose time range misses are skipped unread.
+    void scan(std::int64_t from, std::int64_t to, const std::function<void(const LogRecord&)>& visit);
+
+    [[nodiscard]] const std::vector<SegmentInfo>& segments() const noexcept { return index; }
+    [[nodiscard]] std::uint64_t record_count() const noexcept;
+    [[nodiscard]] std::uint64_t bytes_on_disk() const noexcept;
+    [[nodiscard]] const RecoveryStats& recovery() const noexcept { return recovered; }
+
+private:
+    void recover();
+    void scan_unsealed(SegmentInfo& info, const std::byte* base, size_t file_bytes);
+    void open_new_segment();
+    void map_active(const SegmentInfo& info, bool fresh);
+    void write_batch(const LogRecord* records, size_t count);
+    void seal_active();
+    void sync_range(std::uint64_t from, std::uint64_t to);
+    void apply_retention();
+    void unmap_active() noexcept;
+
+    ReadingLogConfig config;
+    std::vector<SegmentInfo> index;  // oldest first; back() is the active segment
+    std::vector<LogRecord> pending;
+    RecoveryStats recovered;
+    std::uint64_t next_sequence = 1;
+
+    int active_fd = -1;
+    std::byte* active_base = nullptr;
+    size_t active_bytes = 0;
+    std::uint64_t synced_to = 0;
+    std::uint32_t active_epoch = 0;  // stamped on batches written this session
+};
+
+#endif // READING_LOG_HPP
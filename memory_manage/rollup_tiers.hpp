@@ -0,0 +1,198 @@
+#ifndef ROLLUP_TIERS_HPP
+#define ROLLUP_TIERS_HPP
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+// Multi-resolution rollups for one sensor's history.
+//
+// Every reading lands in the raw series and in one bucket per tier (1 s,
+// 1 min and 1 h by default), so maintaining the tiers costs a few adds per
+// reading. A time-range aggregate is planned top-down: the coarsest tier
+// answers the aligned middle of the range, and each finer tier, and finally
+// the raw readings, fill in only the unaligned edges. A year-long query
+// over 1 s data then reads ~9000 hourly buckets, at most ~120 buckets from
+// each finer tier and under two seconds of raw readings.
+//
+// The raw values may live in a vector shared with the caller (DataLogger
+// keeps its per-sensor history there), so a reading is stored once; the
+// series itself adds only its timestamp.
+
+// count/sum/min/max, which merge exactly across buckets
+struct RollupAggregate {
+    std::uint64_t count = 0;
+    double sum = 0.0;
+    float min = std::numeric_limits<float>::infinity();
+    float max = -std::numeric_limits<float>::infinity();
+
+    void add(float value) noexcept {
+        ++count;
+        sum += value;
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+
+    void merge(const RollupAggregate& other) noexcept {
+        count += other.count;
+        sum += other.sum;
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+
+    [[nodiscard]] double mean() const noexcept { return count ? sum / count : 0.0; }
+};
+
+// What a query touched, for tuning and benchmarks
+struct RollupQueryCost {
+    size_t buckets = 0;
+    size_t raw_readings = 0;
+};
+
+class RollupSeries {
+public:
+    // A copy would append to the same shared value storage
+    RollupSeries(const RollupSeries&) = delete;
+    RollupSeries& operator=(const RollupSeries&) = delete;
+    RollupSeries(RollupSeries&&) noexcept = default;
+    RollupSeries& operator=(RollupSeries&&) noexcept = default;
+
+    // Bucket widths in timestamp units, finest first; each must divide the
+    // next. append() pushes each value onto `values`, which must start empty
+    // and must not be modified elsewhere; by default the series owns it.
+    explicit RollupSeries(std::vector<std::int64_t> widths = {1000, 60'000, 3'600'000},
+                          std::shared_ptr<std::vector<float>> values = nullptr)
+        : values(values ? std::move(values) : std::make_shared<std::vector<float>>()), tiers(widths.size()) {
+        if (!this->values->empty()) {
+            throw std::invalid_argument("RollupSeries value storage must start empty");
+        }
+        for (size_t i = 0; i < widths.size(); ++i) {
+            if (widths[i] <= 0 || (i > 0 && widths[i] % widths[i - 1] != 0)) {
+                throw std::invalid_argument("RollupSeries widths must be positive and nested");
+            }
+            tiers[i].width = widths[i];
+        }
+    }
+
+    void append(std::int64_t timestamp, float value) {
+        if (!timestamps.empty() && timestamp < timestamps.back()) {
+            throw std::invalid_argument("RollupSeries timestamps must not decrease");
+        }
+        timestamps.push_back(timestamp);
+        values->push_back(value);
+        for (auto& tier : tiers) {
+            std::int64_t start = floor_to(timestamp, tier.width);
+            if (tier.starts.empty() || tier.starts.back() != start) {
+                tier.starts.push_back(start);
+                tier.buckets.emplace_back();
+            }
+            tier.buckets.back().add(value);
+        }
+    }
+
+    // Aggregate of readings with from <= timestamp < to, using the rollups
+    [[nodiscard]] RollupAggregate aggregate(std::int64_t from, std::int64_t to,
+                                            RollupQueryCost* cost = nullptr) const {
+        RollupAggregate result;
+        RollupQueryCost local;
+        if (from < to) {
+            cover(tiers.size(), from, to, result, cost ? *cost : local);
+        }
+        return result;
+    }
+
+    // The same aggregate from raw readings only, as a baseline
+    [[nodiscard]] RollupAggregate aggregate_raw(std::int64_t from, std::int64_t to) const {
+        RollupAggregate result;
+        if (from < to) {
+            scan_raw(from, to, result);
+        }
+        return result;
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return timestamps.size(); }
+    [[nodiscard]] size_t tier_count() const noexcept { return tiers.size(); }
+    [[nodiscard]] std::int64_t tier_width(size_t tier) const { return tiers.at(tier).width; }
+    [[nodiscard]] size_t bucket_count(size_t tier) const { return tiers.at(tier).buckets.size(); }
+
+    // Raw values in append order, possibly shared with the caller
+    [[nodiscard]] const std::vector<float>& raw_values() const noexcept { return *values; }
+
+    // Includes the value storage, shared or not
+    [[nodiscard]] size_t memory_usage() const noexcept {
+        size_t bytes = timestamps.capacity() * sizeof(std::int64_t) + values->capacity() * sizeof(float);
+        for (const auto& tier : tiers) {
+            bytes += tier.starts.capacity() * sizeof(std::int64_t) +
+                     tier.buckets.capacity() * sizeof(RollupAggregate);
+        }
+        return bytes;
+    }
+
+private:
+    // Buckets are sparse: a gap in the data leaves no empty buckets behind
+    struct Tier {
+        std::int64_t width = 0;
+        std::vector<std::int64_t> starts;
+        std::vector<RollupAggregate> buckets;
+    };
+
+    static std::int64_t floor_to(std::int64_t t, std::int64_t width) noexcept {
+        std::int64_t q = t / width;
+        if (t % width != 0 && t < 0) {
+            --q;
+        }
+        return q * width;
+    }
+
+    // Covers [from, to) with tiers [0, level): whole buckets of level - 1 in
+    // the aligned middle, finer levels for the two edges
+    void cover(size_t level, std::int64_t from, std::int64_t to,
+               RollupAggregate& result, RollupQueryCost& cost) const {
+        if (from >= to) {
+            return;
+        }
+        if (level == 0) {
+            cost.raw_readings += scan_raw(from, to, result);
+            return;
+        }
+        const Tier& tier = tiers[level - 1];
+        std::int64_t first = floor_to(from, tier.width);
+        if (first < from) {
+            first += tier.width;
+        }
+        std::int64_t last = floor_to(to, tier.width);
+        if (first >= last) {
+            cover(level - 1, from, to, result, cost);
+            return;
+        }
+        cover(level - 1, from, first, result, cost);
+        auto begin = std::lower_bound(tier.starts.begin(), tier.starts.end(), first);
+        auto end = std::lower_bound(begin, tier.starts.end(), last);
+        for (auto i = begin - tier.starts.begin(); i < end - tier.starts.begin(); ++i) {
+            result.merge(tier.buckets[i]);
+        }
+        cost.buckets += end - begin;
+        cover(level - 1, last, to, result, cost);
+    }
+
+    size_t scan_raw(std::int64_t from, std::int64_t to, RollupAggregate& result) const {
+        auto begin = std::lower_bound(timestamps.begin(), timestamps.end(), from);
+        auto end = std::lower_bound(begin, timestamps.end(), to);
+        size_t first = begin - timestamps.begin();
+        size_t last = end - timestamps.begin();
+        for (size_t i = first; i < last; ++i) {
+            result.add((*values)[i]);
+        }
+        return last - first;
+    }
+
+    std::vector<std::int64_t> timestamps;
+    std::shared_ptr<std::vector<float>> values;
+    std::vector<Tier> tiers;
+};
+
+#endif // ROLLUP_TIERS_HPP
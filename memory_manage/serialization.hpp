@@ -0,0 +1,402 @@
+#ifndef SERIALIZATION_HPP
+#define SERIALIZATION_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Binary serialization for Queue, Map, Stack and LinkedList.
+//
+// Encoder and Decoder stream through one fixed-size buffer each, so a
+// container of any size is written and read without staging it in memory.
+// Trivially copyable elements go out as their raw bytes: contiguous
+// containers in a single bulk copy, and a section larger than the buffer
+// straight between the sink/source and the container's storage without a
+// copy through the buffer. Strings and vectors are length-prefixed; other
+// element types specialize Codec.
+//
+// Every container opens with a 20-byte frame: magic, container kind, the
+// element layout (sizeof for trivially copyable elements, else 0) and the
+// element count. Data is in host byte order.
+namespace serialization {
+
+class Error : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// A sink takes each full buffer (or a large section directly); a source
+// fills as much of the span as it can and returns 0 at end of input
+using Sink = std::function<void(std::span<const std::byte>)>;
+using Source = std::function<size_t(std::span<std::byte>)>;
+
+inline constexpr size_t default_buffer_bytes = 64 * 1024;
+
+class Encoder;
+class Decoder;
+
+// Specialize for element types that are neither trivially copyable nor
+// covered below: static void encode(Encoder&, const T&) and
+// static void decode(Decoder&, T&)
+template <typename T>
+struct Codec;
+
+// The containers serialize themselves
+template <typename T>
+concept SelfSerializing = requires(const T& c, T& m, Encoder& out, Decoder& in) {
+    c.serialize(out);
+    m.deserialize(in);
+};
+
+template <typename T>
+concept Bitwise = std::is_trivially_copyable_v<T> && !std::is_pointer_v<T> && !SelfSerializing<T>;
+
+// Recorded in the frame so a reader with a different element type fails
+template <typename T>
+inline constexpr std::uint32_t layout_tag = Bitwise<T> ? static_cast<std::uint32_t>(sizeof(T)) : 0;
+
+class Encoder {
+public:
+    explicit Encoder(Sink sink, size_t buffer_bytes = default_buffer_bytes)
+        : sink(std::move(sink)), buffer(std::max<size_t>(buffer_bytes, 64)) {}
+
+    // Call after the last write; the destructor does not flush, since a
+    // failing sink could not report from there
+    void flush() {
+        if (used > 0) {
+            sink(std::span<const std::byte>(buffer.data(), used));
+            used = 0;
+        }
+    }
+
+    void write_bytes(const void* data, size_t n) {
+        if (n == 0) {
+            return;
+        }
+        const auto* bytes = static_cast<const std::byte*>(data);
+        written += n;
+        if (n <= buffer.size() - used) {
+            std::memcpy(buffer.data() + used, bytes, n);
+            used += n;
+            return;
+        }
+        if (n >= buffer.size()) {
+            flush();
+            sink(std::span<const std::byte>(bytes, n));
+            return;
+        }
+        size_t head = buffer.size() - used;
+        std::memcpy(buffer.data() + used, bytes, head);
+        used = buffer.size();
+        flush();
+        std::memcpy(buffer.data(), bytes + head, n - head);
+        used = n - head;
+    }
+
+    template <typename T>
+    void write(const T& value) {
+        if constexpr (Bitwise<T>) {
+            write_bytes(&value, sizeof(T));
+        } else if constexpr (SelfSerializing<T>) {
+            value.serialize(*this);
+        } else {
+            Codec<T>::encode(*this, value);
+        }
+    }
+
+    template <typename T>
+    void write_array(const T* values, size_t n) {
+        if constexpr (Bitwise<T>) {
+            write_bytes(values, n * sizeof(T));
+        } else {
+            for (size_t i = 0; i < n; ++i) {
+                write(values[i]);
+            }
+        }
+    }
+
+    // Writes proj(element) for n elements as one packed section, for a
+    // field of records that are not bitwise as a whole (std::pair never is)
+    template <typename It, typename Proj>
+    void write_field(It first, size_t n, Proj proj) {
+        using T = std::remove_cvref_t<decltype(proj(*first))>;
+        static_assert(Bitwise<T>, "write_field needs a trivially copyable field");
+        written += std::uint64_t{n} * sizeof(T);
+        for (; n > 0; --n, ++first) {
+            if (buffer.size() - used < sizeof(T)) {
+                flush();
+            }
+            const T& value = proj(*first);
+            std::memcpy(buffer.data() + used, &value, sizeof(T));
+            used += sizeof(T);
+        }
+    }
+
+    [[nodiscard]] std::uint64_t bytes_written() const noexcept {
+        return written;
+    }
+
+private:
+    Sink sink;
+    std::vector<std::byte> buffer;
+    size_t used = 0;
+    std::uint64_t written = 0;
+};
+
+class Decoder {
+public:
+    explicit Decoder(Source source, size_t buffer_bytes = default_buffer_bytes)
+        : source(std::move(source)), buffer(std::max<size_t>(buffer_bytes, 64)) {}
+
+    void read_bytes(void* data, size_t n) {
+        if (n == 0) {
+            return;
+        }
+        auto* bytes = static_cast<std::byte*>(data);
+        consumed += n;
+        for (;;) {
+            size_t take = std::min(n, end - pos);
+            std::memcpy(bytes, buffer.data() + pos, take);
+            pos += take;
+            bytes += take;
+            n -= take;
+            if (n == 0) {
+                return;
+            }
+            if (n >= buffer.size()) {
+                // Large sections bypass the buffer
+                while (n > 0) {
+                    size_t got = source(std::span<std::byte>(bytes, n));
+                    if (got == 0) {
+                        throw Error("serialization: input truncated");
+                    }
+                    bytes += got;
+                    n -= got;
+                }
+                return;
+            }
+            pos = 0;
+            end = source(std::span<std::byte>(buffer.data(), buffer.size()));
+            if (end == 0) {
+                throw Error("serialization: input truncated");
+            }
+        }
+    }
+
+    template <typename T>
+    void read(T& value) {
+        if constexpr (Bitwise<T>) {
+            read_bytes(&value, sizeof(T));
+        } else if constexpr (SelfSerializing<T>) {
+            value.deserialize(*this);
+        } else {
+            Codec<T>::decode(*this, value);
+        }
+    }
+
+    template <typename T>
+    T read() {
+        T value{};
+        read(value);
+        return value;
+    }
+
+    // Appends n elements to a vector-like container. The count comes from
+    // the input, so only the first 64 MiB are reserved up front; past that
+    // the container grows as data actually arrives and a corrupt count
+    // fails on truncated input rather than on one huge allocation.
+    template <typename Container>
+    void read_append(Container& c, std::uint64_t n) {
+        using T = typename Container::value_type;
+        constexpr std::uint64_t trusted = (std::uint64_t{64} << 20) / sizeof(T) + 1;
+        c.reserve(c.size() + static_cast<size_t>(std::min(n, trusted)));
+        if constexpr (Bitwise<T>) {
+            while (n > 0) {
+                size_t k = static_cast<size_t>(std::min(n, trusted));
+                size_t old = c.size();
+                c.resize(old + k);
+                read_bytes(c.data() + old, k * sizeof(T));
+                n -= k;
+            }
+        } else {
+            for (; n > 0; --n) {
+                T value{};
+                read(value);
+                c.push_back(std::move(value));
+            }
+        }
+    }
+
+    // Reads a section written by Encoder::write_field into proj(element)
+    // for n elements
+    template <typename It, typename Proj>
+    void read_field(It first, size_t n, Proj proj) {
+        using T = std::remove_cvref_t<decltype(proj(*first))>;
+        static_assert(Bitwise<T>, "read_field needs a trivially copyable field");
+        for (; n > 0; --n, ++first) {
+            T& value = proj(*first);
+            if (end - pos >= sizeof(T)) {
+                std::memcpy(&value, buffer.data() + pos, sizeof(T));
+                pos += sizeof(T);
+                consumed += sizeof(T);
+            } else {
+                read_bytes(&value, sizeof(T));
+            }
+        }
+    }
+
+    [[nodiscard]] std::uint64_t bytes_read() const noexcept {
+        return consumed;
+    }
+
+private:
+    Source source;
+    std::vector<std::byte> buffer;
+    size_t pos = 0;
+    size_t end = 0;
+    std::uint64_t consumed = 0;
+};
+
+template <typename CharT, typename Traits, typename Alloc>
+struct Codec<std::basic_string<CharT, Traits, Alloc>> {
+    static void encode(Encoder& out, const std::basic_string<CharT, Traits, Alloc>& s) {
+        out.write(static_cast<std::uint64_t>(s.size()));
+        out.write_bytes(s.data(), s.size() * sizeof(CharT));
+    }
+
+    static void decode(Decoder& in, std::basic_string<CharT, Traits, Alloc>& s) {
+        s.clear();
+        in.read_append(s, in.read<std::uint64_t>());
+    }
+};
+
+template <typename T, typename Alloc>
+struct Codec<std::vector<T, Alloc>> {
+    static void encode(Encoder& out, const std::vector<T, Alloc>& v) {
+        out.write(static_cast<std::uint64_t>(v.size()));
+        out.write_array(v.data(), v.size());
+    }
+
+    static void decode(Decoder& in, std::vector<T, Alloc>& v) {
+        v.clear();
+        in.read_append(v, in.read<std::uint64_t>());
+    }
+};
+
+template <typename A, typename B>
+struct Codec<std::pair<A, B>> {
+    static void encode(Encoder& out, const std::pair<A, B>& p) {
+        out.write(p.first);
+        out.write(p.second);
+    }
+
+    static void decode(Decoder& in, std::pair<A, B>& p) {
+        in.read(p.first);
+        in.read(p.second);
+    }
+};
+
+enum class ContainerKind : std::uint8_t { queue = 1, map, stack, linked_list };
+
+inline const char* kind_name(ContainerKind kind) noexcept {
+    switch (kind) {
+    case ContainerKind::queue: return "queue";
+    case ContainerKind::map: return "map";
+    case ContainerKind::stack: return "stack";
+    case ContainerKind::linked_list: return "linked_list";
+    }
+    return "unknown";
+}
+
+inline constexpr std::uint32_t frame_magic = 0x31525343;  // "CSR1"
+inline constexpr std::uint8_t frame_version = 2;  // 2: bitwise Map keys and values as two sections
+
+inline void write_header(Encoder& out, ContainerKind kind, std::uint32_t layout, std::uint64_t count) {
+    out.write(frame_magic);
+    out.write(static_cast<std::uint8_t>(kind));
+    out.write(frame_version);
+    out.write(std::uint16_t{0});
+    out.write(layout);
+    out.write(count);
+}
+
+// Checks the frame and returns the element count
+inline std::uint64_t read_header(Decoder& in, ContainerKind kind, std::uint32_t layout) {
+    if (in.read<std::uint32_t>() != frame_magic) {
+        throw Error("serialization: not a container frame");
+    }
+    auto found = static_cast<ContainerKind>(in.read<std::uint8_t>());
+    if (found != kind) {
+        throw Error(std::string("serialization: expected a ") + kind_name(kind) + ", found a " + kind_name(found));
+    }
+    if (in.read<std::uint8_t>() != frame_version) {
+        throw Error("serialization: unsupported frame version");
+    }
+    in.read<std::uint16_t>();
+    if (in.read<std::uint32_t>() != layout) {
+        throw Error(std::string("serialization: element layout of ") + kind_name(kind) + " does not match");
+    }
+    return in.read<std::uint64_t>();
+}
+
+// Sinks and sources for common destinations
+
+inline Sink vector_sink(std::vector<std::byte>& out) {
+    return [&out](std::span<const std::byte> bytes) { out.insert(out.end(), bytes.begin(), bytes.end()); };
+}
+
+inline Source span_source(std::span<const std::byte> in) {
+    return [in, offset = size_t{0}](std::span<std::byte> into) mutable {
+        size_t n = std::min(into.size(), in.size() - offset);
+        std::memcpy(into.data(), in.data() + offset, n);
+        offset += n;
+        return n;
+    };
+}
+
+inline Sink ostream_sink(std::ostream& out) {
+    return [&out](std::span<const std::byte> bytes) {
+        if (!out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+            throw Error("serialization: stream write failed");
+        }
+    };
+}
+
+inline Source istream_source(std::istream& in) {
+    return [&in](std::span<std::byte> into) {
+        in.read(reinterpret_cast<char*>(into.data()), static_cast<std::streamsize>(into.size()));
+        return static_cast<size_t>(in.gcount());
+    };
+}
+
+// Whole-value helpers for small payloads
+
+template <typename T>
+std::vector<std::byte> to_bytes(const T& value) {
+    std::vector<std::byte> bytes;
+    Encoder out(vector_sink(bytes));
+    out.write(value);
+    out.flush();
+    return bytes;
+}
+
+template <typename T>
+void from_bytes(std::span<const std::byte> bytes, T& value) {
+    Decoder in(span_source(bytes));
+    in.read(value);
+}
+
+} // namespace serialization
+
+#endif // SERIALIZATION_HPP
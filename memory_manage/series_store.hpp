@@ -0,0 +1,303 @@
+#ifndef SERIES_STORE_HPP
+#define SERIES_STORE_HPP
+
+#include <vector>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SERIES_STORE_HAVE_AVX2 1
+#include <immintrin.h>
+#endif
+
+// Summary statistics of a run of readings. Partial results from separate
+// runs merge exactly (Chan et al.), so chunks, sensors and threads can be
+// reduced independently and combined in any order.
+struct SeriesStats {
+    size_t count = 0;
+    double sum = 0.0;
+    double m2 = 0.0;  // sum of squared deviations from the mean
+    float min = std::numeric_limits<float>::infinity();
+    float max = -std::numeric_limits<float>::infinity();
+
+    [[nodiscard]] double mean() const noexcept {
+        return count ? sum / count : 0.0;
+    }
+
+    // Population variance
+    [[nodiscard]] double variance() const noexcept {
+        return count ? m2 / count : 0.0;
+    }
+
+    // Welford's single-value update
+    void add(float value) noexcept {
+        double delta = value - mean();
+        ++count;
+        sum += value;
+        m2 += delta * (value - mean());
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+
+    void merge(const SeriesStats& other) noexcept {
+        if (other.count == 0) {
+            return;
+        }
+        if (count == 0) {
+            *this = other;
+            return;
+        }
+        double delta = other.mean() - mean();
+        double total = static_cast<double>(count + other.count);
+        m2 += other.m2 + delta * delta * (static_cast<double>(count) * other.count / total);
+        sum += other.sum;
+        count += other.count;
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+};
+
+// Aggregation kernels over a contiguous float array. Each makes two passes:
+// sum/min/max, then squared deviations from that mean. Callers keep the
+// array cache-sized (the store hands them one chunk at a time), so the
+// second pass reads from L1/L2. Accumulation is in double.
+namespace series_kernels {
+
+inline SeriesStats stats_scalar(const float* values, size_t n) noexcept {
+    SeriesStats s;
+    if (n == 0) {
+        return s;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        s.sum += values[i];
+        s.min = std::min(s.min, values[i]);
+        s.max = std::max(s.max, values[i]);
+    }
+    s.count = n;
+    double mean = s.sum / n;
+    for (size_t i = 0; i < n; ++i) {
+        double d = values[i] - mean;
+        s.m2 += d * d;
+    }
+    return s;
+}
+
+#ifdef SERIES_STORE_HAVE_AVX2
+
+namespace detail {
+
+__attribute__((target("avx2,fma"))) inline double hsum(__m256d v) noexcept {
+    __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
+
+__attribute__((target("avx2,fma"))) inline float hmin(__m256 v) noexcept {
+    __m128 m = _mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    m = _mm_min_ps(m, _mm_movehl_ps(m, m));
+    return _mm_cvtss_f32(_mm_min_ss(m, _mm_shuffle_ps(m, m, 1)));
+}
+
+__attribute__((target("avx2,fma"))) inline float hmax(__m256 v) noexcept {
+    __m128 m = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+    return _mm_cvtss_f32(_mm_max_ss(m, _mm_shuffle_ps(m, m, 1)));
+}
+
+} // namespace detail
+
+// 16 floats per iteration into four independent double accumulators
+__attribute__((target("avx2,fma"))) inline SeriesStats stats_avx2(const float* values, size_t n) noexcept {
+    SeriesStats s;
+    if (n == 0) {
+        return s;
+    }
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    __m256d acc2 = _mm256_setzero_pd(), acc3 = _mm256_setzero_pd();
+    __m256 lo = _mm256_set1_ps(s.min), hi = _mm256_set1_ps(s.max);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256 a = _mm256_loadu_ps(values + i);
+        __m256 b = _mm256_loadu_ps(values + i + 8);
+        acc0 = _mm256_add_pd(acc0, _mm256_cvtps_pd(_mm256_castps256_ps128(a)));
+        acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(_mm256_extractf128_ps(a, 1)));
+        acc2 = _mm256_add_pd(acc2, _mm256_cvtps_pd(_mm256_castps256_ps128(b)));
+        acc3 = _mm256_add_pd(acc3, _mm256_cvtps_pd(_mm256_extractf128_ps(b, 1)));
+        lo = _mm256_min_ps(lo, _mm256_min_ps(a, b));
+        hi = _mm256_max_ps(hi, _mm256_max_ps(a, b));
+    }
+    s.sum = detail::hsum(_mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3)));
+    s.min = detail::hmin(lo);
+    s.max = detail::hmax(hi);
+    for (size_t j = i; j < n; ++j) {
+        s.sum += values[j];
+        s.min = std::min(s.min, values[j]);
+        s.max = std::max(s.max, values[j]);
+    }
+    s.count = n;
+
+    double mean = s.sum / n;
+    __m256d center = _mm256_set1_pd(mean);
+    acc0 = acc1 = acc2 = acc3 = _mm256_setzero_pd();
+    for (i = 0; i + 16 <= n; i += 16) {
+        __m256 a = _mm256_loadu_ps(values + i);
+        __m256 b = _mm256_loadu_ps(values + i + 8);
+        __m256d d0 = _mm256_sub_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(a)), center);
+        __m256d d1 = _mm256_sub_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(a, 1)), center);
+        __m256d d2 = _mm256_sub_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(b)), center);
+        __m256d d3 = _mm256_sub_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(b, 1)), center);
+        acc0 = _mm256_fmadd_pd(d0, d0, acc0);
+        acc1 = _mm256_fmadd_pd(d1, d1, acc1);
+        acc2 = _mm256_fmadd_pd(d2, d2, acc2);
+        acc3 = _mm256_fmadd_pd(d3, d3, acc3);
+    }
+    s.m2 = detail::hsum(_mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3)));
+    for (; i < n; ++i) {
+        double d = values[i] - mean;
+        s.m2 += d * d;
+    }
+    return s;
+}
+
+#endif // SERIES_STORE_HAVE_AVX2
+
+[[nodiscard]] inline bool avx2_available() noexcept {
+#ifdef SERIES_STORE_HAVE_AVX2
+    static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+// Picks the widest kernel the running CPU supports
+inline SeriesStats stats(const float* values, size_t n) noexcept {
+#ifdef SERIES_STORE_HAVE_AVX2
+    if (avx2_available()) {
+        return stats_avx2(values, n);
+    }
+#endif
+    return stats_scalar(values, n);
+}
+
+} // namespace series_kernels
+
+// Column-oriented store of (timestamp, value) readings for a fixed set of
+// sensors. Each sensor owns a list of fixed-size chunks holding a timestamp
+// column and a value column, both 64-byte aligned, so aggregation streams
+// over dense floats instead of chasing per-reading objects. Appending never
+// moves existing readings.
+class SensorSeriesStore {
+public:
+    static constexpr size_t chunk_readings = 4096;
+
+    struct alignas(64) Chunk {
+        std::int64_t timestamps[chunk_readings];
+        float values[chunk_readings];
+    };
+
+    explicit SensorSeriesStore(size_t sensors) : columns(sensors) {}
+
+    void append(size_t sensor, std::int64_t timestamp, float value) {
+        Column& column = column_at(sensor);
+        size_t slot = column.count % chunk_readings;
+        if (slot == 0) {
+            column.chunks.push_back(std::unique_ptr<Chunk>(new Chunk));  // not zeroed
+        }
+        Chunk& chunk = *column.chunks.back();
+        chunk.timestamps[slot] = timestamp;
+        chunk.values[slot] = value;
+        ++column.count;
+    }
+
+    // Bulk append that copies whole runs into each chunk
+    void append(size_t sensor, const std::int64_t* timestamps, const float* values, size_t n) {
+        Column& column = column_at(sensor);
+        while (n > 0) {
+            size_t slot = column.count % chunk_readings;
+            if (slot == 0) {
+                column.chunks.push_back(std::unique_ptr<Chunk>(new Chunk));  // not zeroed
+            }
+            size_t run = std::min(n, chunk_readings - slot);
+            Chunk& chunk = *column.chunks.back();
+            std::copy_n(timestamps, run, chunk.timestamps + slot);
+            std::copy_n(values, run, chunk.values + slot);
+            column.count += run;
+            timestamps += run;
+            values += run;
+            n -= run;
+        }
+    }
+
+    [[nodiscard]] size_t sensor_count() const noexcept {
+        return columns.size();
+    }
+
+    [[nodiscard]] size_t reading_count(size_t sensor) const {
+        return column_at(sensor).count;
+    }
+
+    // Calls func(timestamps, values, n) for each chunk of a sensor, oldest first
+    template <typename Func>
+    void for_each_chunk(size_t sensor, Func&& func) const {
+        const Column& column = column_at(sensor);
+        size_t remaining = column.count;
+        for (const auto& chunk : column.chunks) {
+            size_t n = std::min(remaining, chunk_readings);
+            func(static_cast<const std::int64_t*>(chunk->timestamps), static_cast<const float*>(chunk->values), n);
+            remaining -= n;
+        }
+    }
+
+    [[nodiscard]] SeriesStats stats(size_t sensor) const {
+        SeriesStats total;
+        for_each_chunk(sensor, [&total](const std::int64_t*, const float* values, size_t n) {
+            total.merge(series_kernels::stats(values, n));
+        });
+        return total;
+    }
+
+    // One entry per sensor
+    [[nodiscard]] std::vector<SeriesStats> stats_each() const {
+        std::vector<SeriesStats> result;
+        result.reserve(columns.size());
+        for (size_t sensor = 0; sensor < columns.size(); ++sensor) {
+            result.push_back(stats(sensor));
+        }
+        return result;
+    }
+
+    // Every reading of every sensor as one population
+    [[nodiscard]] SeriesStats stats_all() const {
+        SeriesStats total;
+        for (size_t sensor = 0; sensor < columns.size(); ++sensor) {
+            total.merge(stats(sensor));
+        }
+        return total;
+    }
+
+private:
+    struct Column {
+        std::vector<std::unique_ptr<Chunk>> chunks;
+        size_t count = 0;
+    };
+
+    Column& column_at(size_t sensor) {
+        if (sensor >= columns.size()) {
+            throw std::out_of_range("Sensor " + std::to_string(sensor) + " is not in the store");
+        }
+        return columns[sensor];
+    }
+
+    const Column& column_at(size_t sensor) const {
+        return const_cast<SensorSeriesStore*>(this)->column_at(sensor);
+    }
+
+    std::vector<Column> columns;
+};
+
+#endif // SERIES_STORE_HPP
@@ -0,0 +1,233 @@
+#ifndef TEMPERATURE_SENSOR_HPP
+#define TEMPERATURE_SENSOR_HPP
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+#include "philox.hpp"
+
+// What can go wrong with a reading
+enum class SensorFault {
+    spike,    // reading off by +/- spikeMagnitude
+    dropout,  // no reading: NaN
+    stuck     // reading pinned at stuckValue
+};
+
+// Synthetic signal: baseline + drift * reading index + Gaussian noise, with
+// a fraction of readings replaced by a fault
+struct SensorModel {
+    std::optional<float> baseline;  // unset: 20.45 + 1.5 * sensor id
+    float noiseStddev = 0.29f;       // matches the old uniform 0.0..0.9 jitter
+    float driftPerReading = 0.0f;
+    double faultRate = 0.0;          // probability per reading
+    SensorFault fault = SensorFault::spike;
+    float spikeMagnitude = 10.0f;
+    float stuckValue = 85.0f;        // the DS18B20 power-on reset value
+};
+
+// Reading kernels. Reading k of a sensor is one Philox block of counter
+// (k low, k high, sensor id, 0) under the sensor's key, so it depends on
+// nothing but (seed, id, k). Bits 8..31 of the four words give four 24-bit
+// uniforms summed into an Irwin-Hall approximation of a standard normal;
+// bits 0..6 form a 28-bit fault draw and bit 7 of word 0 the spike sign.
+// The scalar and AVX2 kernels do the same float operations in the same
+// order and produce identical output.
+namespace sensor_kernels {
+
+struct ReadingParams {
+    philox::Key key{};
+    std::uint32_t sensor = 0;
+    float baseline = 0.0f;
+    float noise = 0.0f;
+    float drift = 0.0f;
+    std::uint32_t faultThreshold = 0;  // fault when the 28-bit draw is below this
+    SensorFault fault = SensorFault::spike;
+    float spike = 0.0f;
+    float stuck = 0.0f;
+};
+
+inline constexpr float unit24 = 1.0f / 16777216.0f;
+inline constexpr float sqrt3 = 1.7320508f;  // Irwin-Hall(4) has variance 1/3
+
+inline float driftAt(const ReadingParams& p, std::uint64_t index) noexcept {
+    return p.drift * static_cast<float>(index);
+}
+
+inline float reading(const ReadingParams& p, std::uint64_t index) noexcept {
+    philox::Counter w = philox::block(
+        {static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(index >> 32), p.sensor, 0}, p.key);
+    float u0 = static_cast<float>(w[0] >> 8) * unit24;
+    float u1 = static_cast<float>(w[1] >> 8) * unit24;
+    float u2 = static_cast<float>(w[2] >> 8) * unit24;
+    float u3 = static_cast<float>(w[3] >> 8) * unit24;
+    float gauss = (u0 + u1 + u2 + u3 - 2.0f) * sqrt3;
+    float value = p.baseline + driftAt(p, index) + p.noise * gauss;
+
+    std::uint32_t draw = (w[0] & 0x7F) | (w[1] & 0x7F) << 7 | (w[2] & 0x7F) << 14 | (w[3] & 0x7F) << 21;
+    if (draw < p.faultThreshold) {
+        switch (p.fault) {
+        case SensorFault::spike:
+            value = value + ((w[0] & 0x80) ? p.spike : -p.spike);
+            break;
+        case SensorFault::dropout:
+            value = std::numeric_limits<float>::quiet_NaN();
+            break;
+        case SensorFault::stuck:
+            value = p.stuck;
+            break;
+        }
+    }
+    return value;
+}
+
+inline void fill_scalar(const ReadingParams& p, std::uint64_t first, float* out, size_t n) noexcept {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = reading(p, first + i);
+    }
+}
+
+#ifdef PHILOX_HAVE_AVX2
+
+// Eight consecutive readings per iteration, one per lane
+__attribute__((target("avx2"))) inline void fill_avx2(const ReadingParams& p, std::uint64_t first, float* out,
+                                                      size_t n) noexcept {
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i signBit = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+    const __m256i low7 = _mm256_set1_epi32(0x7F);
+    const __m256i spikeSign = _mm256_set1_epi32(0x80);
+    const __m256i sensor = _mm256_set1_epi32(static_cast<int>(p.sensor));
+    const __m256i threshold = _mm256_set1_epi32(static_cast<int>(p.faultThreshold));
+    const __m256 unit = _mm256_set1_ps(unit24);
+    const __m256 two = _mm256_set1_ps(2.0f);
+    const __m256 scale = _mm256_set1_ps(sqrt3);
+    const __m256 baseline = _mm256_set1_ps(p.baseline);
+    const __m256 noise = _mm256_set1_ps(p.noise);
+    const __m256 spikeUp = _mm256_set1_ps(p.spike);
+    const __m256 spikeDown = _mm256_set1_ps(-p.spike);
+    const __m256 nan = _mm256_set1_ps(std::numeric_limits<float>::quiet_NaN());
+    const __m256 stuck = _mm256_set1_ps(p.stuck);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        std::uint64_t index = first + i;
+        __m256i start = _mm256_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(index)));
+        __m256i lo = _mm256_add_epi32(start, lanes);
+        // Lanes whose low word wrapped carry into the high word
+        __m256i wrapped = _mm256_cmpgt_epi32(_mm256_xor_si256(start, signBit), _mm256_xor_si256(lo, signBit));
+        __m256i hi = _mm256_sub_epi32(_mm256_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(index >> 32))),
+                                      wrapped);
+        __m256i w[4] = {lo, hi, sensor, _mm256_setzero_si256()};
+        philox::block8(w, p.key);
+
+        __m256 u0 = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(w[0], 8)), unit);
+        __m256 u1 = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(w[1], 8)), unit);
+        __m256 u2 = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(w[2], 8)), unit);
+        __m256 u3 = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(w[3], 8)), unit);
+        __m256 sum = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(u0, u1), u2), u3);
+        __m256 gauss = _mm256_mul_ps(_mm256_sub_ps(sum, two), scale);
+
+        __m256 level = baseline;
+        if (p.drift != 0.0f) {
+            alignas(32) float drift[8];
+            for (int l = 0; l < 8; ++l) {
+                drift[l] = driftAt(p, index + l);
+            }
+            level = _mm256_add_ps(level, _mm256_load_ps(drift));
+        }
+        __m256 value = _mm256_add_ps(level, _mm256_mul_ps(noise, gauss));
+
+        if (p.faultThreshold != 0) {
+            __m256i draw = _mm256_or_si256(
+                _mm256_or_si256(_mm256_and_si256(w[0], low7), _mm256_slli_epi32(_mm256_and_si256(w[1], low7), 7)),
+                _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(w[2], low7), 14),
+                                _mm256_slli_epi32(_mm256_and_si256(w[3], low7), 21)));
+            // Both sides are below 2^31, so the signed compare is exact
+            __m256 hit = _mm256_castsi256_ps(_mm256_cmpgt_epi32(threshold, draw));
+            __m256 faulty = stuck;
+            if (p.fault == SensorFault::spike) {
+                __m256 down = _mm256_castsi256_ps(
+                    _mm256_cmpeq_epi32(_mm256_and_si256(w[0], spikeSign), _mm256_setzero_si256()));
+                faulty = _mm256_add_ps(value, _mm256_blendv_ps(spikeUp, spikeDown, down));
+            } else if (p.fault == SensorFault::dropout) {
+                faulty = nan;
+            }
+            value = _mm256_blendv_ps(value, faulty, hit);
+        }
+        _mm256_storeu_ps(out + i, value);
+    }
+    fill_scalar(p, first + i, out + i, n - i);
+}
+
+#endif // PHILOX_HAVE_AVX2
+
+// Picks the widest kernel the running CPU supports
+inline void fill(const ReadingParams& p, std::uint64_t first, float* out, size_t n) noexcept {
+#ifdef PHILOX_HAVE_AVX2
+    if (philox::avx2_available()) {
+        fill_avx2(p, first, out, n);
+        return;
+    }
+#endif
+    fill_scalar(p, first, out, n);
+}
+
+} // namespace sensor_kernels
+
+// Simulates a hardware temperature sensor. Readings come from a
+// counter-based generator keyed by (seed, id), so each sensor is an
+// independent deterministic stream with no shared state: sensors can be
+// polled from any number of threads, and a given seed replays the same
+// readings. One sensor object is not itself safe to read from two threads.
+class TemperatureSensor {
+public:
+    static constexpr std::uint64_t defaultSeed = 0x5EED'7E3A'9C11'D2B4;
+
+    TemperatureSensor(int id, const SensorModel& model = {}, std::uint64_t seed = defaultSeed) : sensorId(id) {
+        params.key = philox::make_key(seed);
+        params.sensor = static_cast<std::uint32_t>(id);
+        params.baseline = model.baseline.value_or(20.45f + id * 1.5f);
+        params.noise = model.noiseStddev;
+        params.drift = model.driftPerReading;
+        params.faultThreshold = static_cast<std::uint32_t>(std::clamp(model.faultRate, 0.0, 1.0) * (1u << 28));
+        params.fault = model.fault;
+        params.spike = model.spikeMagnitude;
+        params.stuck = model.stuckValue;
+    }
+
+    float readTemperature() {
+        return sensor_kernels::reading(params, nextReading++);
+    }
+
+    // Fills `out` with the next out.size() readings, eight at a time with AVX2
+    void readTemperatures(std::span<float> out) {
+        sensor_kernels::fill(params, nextReading, out.data(), out.size());
+        nextReading += out.size();
+    }
+
+    // Reading `index` of this sensor's stream, without moving the cursor
+    float readingAt(std::uint64_t index) const {
+        return sensor_kernels::reading(params, index);
+    }
+
+    std::uint64_t readingsTaken() const {
+        return nextReading;
+    }
+
+    void seek(std::uint64_t index) {
+        nextReading = index;
+    }
+
+    int id() const {
+        return sensorId;
+    }
+
+private:
+    int sensorId;
+    std::uint64_t nextReading = 0;
+    sensor_kernels::ReadingParams params;
+};
+
+#endif // TEMPERATURE_SENSOR_HPP
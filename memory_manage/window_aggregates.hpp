@@ -0,0 +1,338 @@
+#ifndef WINDOW_AGGREGATES_HPP
+#define WINDOW_AGGREGATES_HPP
+
+#include <deque>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+#include "series_store.hpp"
+
+// Incremental aggregates over a moving window of readings. Every update and
+// every query is O(1) (amortized for the deque-based pieces), so a dashboard
+// can ask for the last N readings or the last N milliseconds as often as it
+// likes without rescanning history.
+
+// Compensated running sum (Neumaier's variant of Kahan summation). Values
+// can be subtracted again, which is what a sliding window needs.
+class KahanSum {
+public:
+    void add(double value) noexcept {
+        double t = sum + value;
+        if (std::fabs(sum) >= std::fabs(value)) {
+            compensation += (sum - t) + value;
+        } else {
+            compensation += (value - t) + sum;
+        }
+        sum = t;
+    }
+
+    void subtract(double value) noexcept {
+        add(-value);
+    }
+
+    [[nodiscard]] double value() const noexcept {
+        return sum + compensation;
+    }
+
+    void reset() noexcept {
+        sum = compensation = 0.0;
+    }
+
+private:
+    double sum = 0.0;
+    double compensation = 0.0;
+};
+
+// Welford mean/variance that also supports removing a value added earlier
+class RunningVariance {
+public:
+    void add(double value) noexcept {
+        ++n;
+        double delta = value - running_mean;
+        running_mean += delta / n;
+        m2 += delta * (value - running_mean);
+    }
+
+    void remove(double value) noexcept {
+        if (n <= 1) {
+            reset();
+            return;
+        }
+        double old_mean = running_mean;
+        running_mean = (old_mean * n - value) / (n - 1);
+        m2 -= (value - old_mean) * (value - running_mean);
+        --n;
+    }
+
+    [[nodiscard]] size_t count() const noexcept { return n; }
+    [[nodiscard]] double mean() const noexcept { return running_mean; }
+
+    // Sum of squared deviations; removals can leave a tiny negative residue
+    [[nodiscard]] double sum_squares() const noexcept { return std::max(m2, 0.0); }
+
+    [[nodiscard]] double variance() const noexcept {
+        return n ? sum_squares() / n : 0.0;
+    }
+
+    void reset() noexcept {
+        n = 0;
+        running_mean = m2 = 0.0;
+    }
+
+private:
+    size_t n = 0;
+    double running_mean = 0.0;
+    double m2 = 0.0;
+};
+
+// Window min and max via monotonic deques. Each entry is tagged with the
+// sequence number of its reading; evict_through(seq) drops readings up to
+// and including seq.
+class MonotonicMinMax {
+public:
+    void push(std::uint64_t seq, float value) {
+        while (!mins.empty() && mins.back().value >= value) {
+            mins.pop_back();
+        }
+        mins.push_back({seq, value});
+        while (!maxs.empty() && maxs.back().value <= value) {
+            maxs.pop_back();
+        }
+        maxs.push_back({seq, value});
+    }
+
+    void evict_through(std::uint64_t seq) {
+        while (!mins.empty() && mins.front().seq <= seq) {
+            mins.pop_front();
+        }
+        while (!maxs.empty() && maxs.front().seq <= seq) {
+            maxs.pop_front();
+        }
+    }
+
+    [[nodiscard]] float min() const noexcept {
+        return mins.empty() ? std::numeric_limits<float>::infinity() : mins.front().value;
+    }
+
+    [[nodiscard]] float max() const noexcept {
+        return maxs.empty() ? -std::numeric_limits<float>::infinity() : maxs.front().value;
+    }
+
+    void clear() noexcept {
+        mins.clear();
+        maxs.clear();
+    }
+
+private:
+    struct Entry {
+        std::uint64_t seq;
+        float value;
+    };
+
+    std::deque<Entry> mins;
+    std::deque<Entry> maxs;
+};
+
+// FIFO window over any associative op, invertible or not (max, gcd, string
+// concatenation, matrix products, ...). The back stack holds a running
+// aggregate of recent pushes; when the front stack runs dry the back stack
+// is flipped onto it with suffix aggregates, so each element is combined a
+// constant number of times over its lifetime.
+template <typename T, typename Op>
+class TwoStacksWindow {
+public:
+    explicit TwoStacksWindow(Op op = Op()) : op(std::move(op)) {}
+
+    void push(const T& value) {
+        back.push_back({value, back.empty() ? value : op(back.back().aggregate, value)});
+    }
+
+    // Drops the oldest element
+    void pop() {
+        if (front.empty()) {
+            flip();
+        }
+        if (front.empty()) {
+            throw std::out_of_range("TwoStacksWindow is empty");
+        }
+        front.pop_back();
+    }
+
+    // Combination of every element, oldest first
+    [[nodiscard]] T query() const {
+        if (front.empty() && back.empty()) {
+            throw std::out_of_range("TwoStacksWindow is empty");
+        }
+        if (front.empty()) {
+            return back.back().aggregate;
+        }
+        if (back.empty()) {
+            return front.back().aggregate;
+        }
+        return op(front.back().aggregate, back.back().aggregate);
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return front.size() + back.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+
+private:
+    struct Entry {
+        T value;
+        T aggregate;
+    };
+
+    void flip() {
+        while (!back.empty()) {
+            T value = std::move(back.back().value);
+            back.pop_back();
+            T aggregate = front.empty() ? value : op(value, front.back().aggregate);
+            front.push_back({std::move(value), std::move(aggregate)});
+        }
+    }
+
+    [[no_unique_address]] Op op;
+    std::vector<Entry> front;  // top is the oldest element
+    std::vector<Entry> back;   // top is the newest element
+};
+
+// The last N readings or the readings of the last N time units, with sum,
+// mean, min, max and variance all available in O(1).
+class SlidingWindow {
+public:
+    static SlidingWindow last_readings(size_t readings) {
+        if (readings == 0) {
+            throw std::invalid_argument("SlidingWindow needs room for at least one reading");
+        }
+        return SlidingWindow(readings, 0);
+    }
+
+    // Keeps readings with timestamp > newest - span
+    static SlidingWindow last_duration(std::int64_t span) {
+        if (span <= 0) {
+            throw std::invalid_argument("SlidingWindow span must be positive");
+        }
+        return SlidingWindow(0, span);
+    }
+
+    void push(std::int64_t timestamp, float value) {
+        readings.push_back({timestamp, value});
+        total.add(value);
+        moments.add(value);
+        extremes.push(next_seq++, value);
+        if (max_readings && readings.size() > max_readings) {
+            evict_oldest();
+        }
+        advance_to(timestamp);
+    }
+
+    // Expires readings that have aged out by `now` without adding one
+    void advance_to(std::int64_t now) {
+        if (span == 0) {
+            return;
+        }
+        while (!readings.empty() && readings.front().timestamp <= now - span) {
+            evict_oldest();
+        }
+    }
+
+    [[nodiscard]] size_t count() const noexcept { return readings.size(); }
+    [[nodiscard]] double sum() const noexcept { return total.value(); }
+    [[nodiscard]] double mean() const noexcept { return readings.empty() ? 0.0 : total.value() / readings.size(); }
+    [[nodiscard]] double variance() const noexcept { return moments.variance(); }
+    [[nodiscard]] float min() const noexcept { return extremes.min(); }
+    [[nodiscard]] float max() const noexcept { return extremes.max(); }
+
+    [[nodiscard]] SeriesStats stats() const noexcept {
+        SeriesStats s;
+        s.count = count();
+        s.sum = sum();
+        s.m2 = moments.sum_squares();
+        s.min = min();
+        s.max = max();
+        return s;
+    }
+
+private:
+    struct Reading {
+        std::int64_t timestamp;
+        float value;
+    };
+
+    SlidingWindow(size_t max_readings, std::int64_t span) : max_readings(max_readings), span(span) {}
+
+    void evict_oldest() {
+        float value = readings.front().value;
+        readings.pop_front();
+        total.subtract(value);
+        moments.remove(value);
+        extremes.evict_through(next_seq - readings.size() - 1);
+    }
+
+    size_t max_readings;
+    std::int64_t span;
+    std::deque<Reading> readings;
+    KahanSum total;
+    RunningVariance moments;
+    MonotonicMinMax extremes;
+    std::uint64_t next_seq = 0;
+};
+
+// Fixed, non-overlapping buckets [k * width, (k + 1) * width). The open
+// bucket accumulates; when a reading lands past it, the bucket closes and
+// stays queryable as last_closed().
+class TumblingWindow {
+public:
+    explicit TumblingWindow(std::int64_t width) : width(width) {
+        if (width <= 0) {
+            throw std::invalid_argument("TumblingWindow width must be positive");
+        }
+    }
+
+    // Returns true if this reading closed the previous bucket
+    bool push(std::int64_t timestamp, float value) {
+        std::int64_t start = bucket_start(timestamp);
+        bool closed = false;
+        if (current.count > 0 && start != current_start) {
+            closed_stats = current;
+            closed_start = current_start;
+            current = SeriesStats();
+            closed = true;
+        }
+        current_start = start;
+        current.add(value);
+        return closed;
+    }
+
+    [[nodiscard]] const SeriesStats& open_bucket() const noexcept { return current; }
+    [[nodiscard]] std::int64_t open_bucket_start() const noexcept { return current_start; }
+    [[nodiscard]] const SeriesStats& last_closed() const noexcept { return closed_stats; }
+    [[nodiscard]] std::int64_t last_closed_start() const noexcept { return closed_start; }
+    [[nodiscard]] std::int64_t bucket_width() const noexcept { return width; }
+
+private:
+    std::int64_t bucket_start(std::int64_t timestamp) const noexcept {
+        std::int64_t q = timestamp / width;
+        if (timestamp % width < 0) {
+            --q;  // floor for timestamps before the epoch
+        }
+        return q * width;
+    }
+
+    std::int64_t width;
+    SeriesStats current;
+    std::int64_t current_start = 0;
+    SeriesStats closed_stats;
+    std::int64_t closed_start = 0;
+};
+
+#endif // WINDOW_AGGREGATES_HPP
@@ -3,14 +3,23 @@
 #define QUEUE_HPP
 
 #include <vector>
+#include <memory>
 #include <stdexcept>
+#include "../memory_manage/container_stats.hpp"
+#include "../memory_manage/serialization.hpp"
 
-template<typename T>
+template<typename T, typename Allocator = std::allocator<T>>
 class Queue {
 private:
-    std::vector<T> elements;
+    std::vector<T, Allocator> elements;
+    [[no_unique_address]] container_stats::InstanceStats<container_stats::Kind::queue> stats;
 
 public:
+    Queue() = default;
+
+    // Store the elements using the given allocator (e.g. a pmr arena)
+    explicit Queue(const Allocator& alloc) : elements(alloc) {}
+
     // Add something to the back of the queue
     void enqueue(const T& item);
     
@@ -25,37 +34,66 @@ public:
     
     // Get the number of items in the queue
     size_t size() const;
+
+    // Binary form: frame, then the elements front to back (see
+    // serialization.hpp). deserialize replaces the contents and leaves them
+    // untouched if the input is bad
+    void serialize(serialization::Encoder& out) const;
+    void deserialize(serialization::Decoder& in);
+
+    // Reallocations and elements shifted by dequeue; all zero unless built
+    // with CONTAINER_STATS (see container_stats.hpp)
+    const container_stats::Counters& getStats() const { return stats.counters(); }
 };
 
 // Implementation of template class methods
-template<typename T>
-void Queue<T>::enqueue(const T& item) {
+template<typename T, typename Allocator>
+void Queue<T, Allocator>::enqueue(const T& item) {
+    size_t capacity = elements.capacity();
     elements.push_back(item);
+    stats.grow(capacity * sizeof(T), elements.capacity() * sizeof(T), elements.size() - 1, sizeof(T));
 }
 
-template<typename T>
-void Queue<T>::dequeue() {
+template<typename T, typename Allocator>
+void Queue<T, Allocator>::dequeue() {
     if (!isEmpty()) {
         elements.erase(elements.begin());
+        stats.move(elements.size(), elements.size() * sizeof(T));
     }
 }
 
-template<typename T>
-T Queue<T>::front() const {
+template<typename T, typename Allocator>
+T Queue<T, Allocator>::front() const {
     if (!isEmpty()) {
         return elements.front();
     }
     throw std::out_of_range("Queue is empty");
 }
 
-template<typename T>
-bool Queue<T>::isEmpty() const {
+template<typename T, typename Allocator>
+bool Queue<T, Allocator>::isEmpty() const {
     return elements.empty();
 }
 
-template<typename T>
-size_t Queue<T>::size() const {
+template<typename T, typename Allocator>
+size_t Queue<T, Allocator>::size() const {
     return elements.size();
 }
 
+template<typename T, typename Allocator>
+void Queue<T, Allocator>::serialize(serialization::Encoder& out) const {
+    serialization::write_header(out, serialization::ContainerKind::queue, serialization::layout_tag<T>, elements.size());
+    out.write_array(elements.data(), elements.size());
+}
+
+template<typename T, typename Allocator>
+void Queue<T, Allocator>::deserialize(serialization::Decoder& in) {
+    std::uint64_t count = serialization::read_header(in, serialization::ContainerKind::queue, serialization::layout_tag<T>);
+    std::vector<T, Allocator> incoming(elements.get_allocator());
+    in.read_append(incoming, count);
+    stats.free(elements.capacity() * sizeof(T));
+    stats.allocation(incoming.capacity() * sizeof(T));
+    elements.swap(incoming);
+}
+
 #endif // QUEUE_HPP
\ No newline at end of file
@@ -0,0 +1,92 @@
+// spsc_ring.hpp
+#ifndef SPSC_RING_HPP
+#define SPSC_RING_HPP
+
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <type_traits>
+#include <bit>
+#include <cstddef>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. Items move in batches: one release store publishes a whole run,
+// and each side caches the other's index so it only touches the shared
+// cache line when it appears to be full (or empty).
+template <typename T>
+class SpscRing {
+    static_assert(std::is_trivially_copyable_v<T>, "SpscRing copies items as plain bytes");
+
+public:
+    // Capacity is rounded up to a power of two
+    explicit SpscRing(size_t min_capacity)
+        : mask(std::bit_ceil(std::max<size_t>(min_capacity, 2)) - 1),
+          slots(std::make_unique<T[]>(mask + 1)) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer side. Copies up to n items and returns how many fit.
+    size_t try_push(const T* items, size_t n) noexcept {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t free_slots = capacity() - (t - cached_head);
+        if (free_slots < n) {
+            cached_head = head.load(std::memory_order_acquire);
+            free_slots = capacity() - (t - cached_head);
+        }
+        n = std::min(n, free_slots);
+        for (size_t i = 0; i < n; ++i) {
+            slots[(t + i) & mask] = items[i];
+        }
+        tail.store(t + n, std::memory_order_release);
+        return n;
+    }
+
+    bool try_push(const T& item) noexcept {
+        return try_push(&item, 1) == 1;
+    }
+
+    // Consumer side. Moves up to max items into out and returns the count.
+    size_t try_pop(T* out, size_t max) noexcept {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t available = cached_tail - h;
+        if (available < max) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            available = cached_tail - h;
+        }
+        size_t n = std::min(max, available);
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = slots[(h + i) & mask];
+        }
+        head.store(h + n, std::memory_order_release);
+        return n;
+    }
+
+    bool try_pop(T& out) noexcept {
+        return try_pop(&out, 1) == 1;
+    }
+
+    // Safe to call from any thread; exact only when both sides are idle
+    [[nodiscard]] size_t size_approx() const noexcept {
+        size_t h = head.load(std::memory_order_acquire);
+        size_t t = tail.load(std::memory_order_acquire);
+        return t >= h ? t - h : 0;
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept {
+        return mask + 1;
+    }
+
+private:
+    // Consumer-owned line
+    alignas(64) std::atomic<size_t> head{0};
+    size_t cached_tail = 0;
+    // Producer-owned line
+    alignas(64) std::atomic<size_t> tail{0};
+    size_t cached_head = 0;
+
+    alignas(64) size_t mask;
+    std::unique_ptr<T[]> slots;
+};
+
+#endif // SPSC_RING_HPP
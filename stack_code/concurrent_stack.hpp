@@ -0,0 +1,287 @@
+#ifndef CONCURRENT_STACK_HPP
+#define CONCURRENT_STACK_HPP
+
+#include <atomic>
+#include <array>
+#include <vector>
+#include <optional>
+#include <concepts>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+// Lock-free LIFO (Treiber stack) for sharing free-lists and work pools
+// between threads.
+//
+// ABA protection: the head word packs a 48-bit node pointer with a 16-bit
+// version tag that changes on every successful update, so a stale
+// compare-exchange fails even if the same node is back on top.
+//
+// Memory reclamation: nodes are never handed back to the allocator while the
+// stack is alive. Popped nodes go onto an internal free-list (itself a tagged
+// Treiber stack) and are reused by later pushes, so a thread that loses a
+// race may still read a node's next pointer safely. Everything is freed in
+// the destructor, which must not run concurrently with other operations.
+//
+// Contention: when a compare-exchange on the head fails, pushers park their
+// node in an elimination array where a concurrent popper can take it
+// directly, so symmetric push/pop pairs cancel out without touching head.
+template <typename T>
+requires std::movable<T>
+class ConcurrentStack {
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        std::optional<T> value;
+    };
+
+    static_assert(sizeof(void*) == 8, "tagged pointers need a 64-bit address space");
+
+    static constexpr int tag_shift = 48;
+    static constexpr std::uint64_t pointer_mask = (std::uint64_t{1} << tag_shift) - 1;
+
+    static Node* pointer_of(std::uint64_t word) noexcept {
+        return reinterpret_cast<Node*>(word & pointer_mask);
+    }
+
+    static std::uint64_t pack(Node* node, std::uint64_t previous) noexcept {
+        std::uint64_t tag = (previous >> tag_shift) + 1;
+        return (tag << tag_shift) | reinterpret_cast<std::uint64_t>(node);
+    }
+
+    // Links the private chain [first, last] on top of the list at `list`
+    static void push_nodes(std::atomic<std::uint64_t>& list, Node* first, Node* last) noexcept {
+        std::uint64_t old_head = list.load(std::memory_order_relaxed);
+        do {
+            last->next.store(pointer_of(old_head), std::memory_order_relaxed);
+        } while (!list.compare_exchange_weak(old_head, pack(first, old_head),
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed));
+    }
+
+    static Node* pop_node(std::atomic<std::uint64_t>& list) noexcept {
+        std::uint64_t old_head = list.load(std::memory_order_acquire);
+        while (Node* top = pointer_of(old_head)) {
+            Node* next = top->next.load(std::memory_order_relaxed);
+            if (list.compare_exchange_weak(old_head, pack(next, old_head),
+                                           std::memory_order_acquire,
+                                           std::memory_order_acquire)) {
+                return top;
+            }
+        }
+        return nullptr;
+    }
+
+    // Slots hold tagged node pointers so that a recycled node offered again
+    // in the same slot is not mistaken for the original offer.
+    class EliminationArray {
+    public:
+        bool try_give(Node* node) noexcept {
+            Slot& slot = slots[pick()];
+            std::uint64_t empty = slot.word.load(std::memory_order_relaxed);
+            if (pointer_of(empty) != nullptr) {
+                return false;
+            }
+            std::uint64_t offer = pack(node, empty);
+            if (!slot.word.compare_exchange_strong(empty, offer,
+                                                   std::memory_order_release,
+                                                   std::memory_order_relaxed)) {
+                return false;
+            }
+            for (int spin = 0; spin < spin_limit; ++spin) {
+                if (slot.word.load(std::memory_order_acquire) != offer) {
+                    return true;
+                }
+                pause();
+            }
+            // Withdraw the offer; failure means a popper took it meanwhile
+            return !slot.word.compare_exchange_strong(offer, pack(nullptr, offer),
+                                                      std::memory_order_acquire,
+                                                      std::memory_order_relaxed);
+        }
+
+        Node* try_take() noexcept {
+            Slot& slot = slots[pick()];
+            std::uint64_t offer = slot.word.load(std::memory_order_acquire);
+            Node* node = pointer_of(offer);
+            if (node != nullptr &&
+                slot.word.compare_exchange_strong(offer, pack(nullptr, offer),
+                                                  std::memory_order_acquire,
+                                                  std::memory_order_relaxed)) {
+                return node;
+            }
+            return nullptr;
+        }
+
+    private:
+        static constexpr size_t slot_count = 8;
+        static constexpr int spin_limit = 128;
+
+        struct alignas(64) Slot {
+            std::atomic<std::uint64_t> word{0};
+        };
+
+        static size_t pick() noexcept {
+            // xorshift per thread; only needs to spread threads over slots
+            thread_local std::uint32_t state =
+                static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(&state)) | 1u;
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state % slot_count;
+        }
+
+        static void pause() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        }
+
+        std::array<Slot, slot_count> slots;
+    };
+
+    Node* make_node() {
+        Node* node = pop_node(free_nodes);
+        return node ? node : new Node;
+    }
+
+    void recycle(Node* node) noexcept {
+        node->value.reset();
+        push_nodes(free_nodes, node, node);
+    }
+
+    static void delete_chain(Node* node) noexcept {
+        while (node) {
+            Node* next = node->next.load(std::memory_order_relaxed);
+            delete node;
+            node = next;
+        }
+    }
+
+    alignas(64) std::atomic<std::uint64_t> head{0};
+    alignas(64) std::atomic<std::uint64_t> free_nodes{0};
+    EliminationArray elimination;
+
+public:
+    ConcurrentStack() = default;
+    ConcurrentStack(const ConcurrentStack&) = delete;
+    ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+    ~ConcurrentStack() {
+        delete_chain(pointer_of(head.load(std::memory_order_acquire)));
+        delete_chain(pointer_of(free_nodes.load(std::memory_order_acquire)));
+    }
+
+    template <typename U>
+    requires std::convertible_to<U, T>
+    void push(U&& value) {
+        Node* node = make_node();
+        try {
+            node->value.emplace(std::forward<U>(value));
+        } catch (...) {
+            recycle(node);
+            throw;
+        }
+
+        std::uint64_t old_head = head.load(std::memory_order_relaxed);
+        for (;;) {
+            node->next.store(pointer_of(old_head), std::memory_order_relaxed);
+            if (head.compare_exchange_weak(old_head, pack(node, old_head),
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+                return;
+            }
+            if (elimination.try_give(node)) {
+                return;
+            }
+            old_head = head.load(std::memory_order_relaxed);
+        }
+    }
+
+    std::optional<T> try_pop() {
+        std::uint64_t old_head = head.load(std::memory_order_acquire);
+        for (;;) {
+            Node* top = pointer_of(old_head);
+            if (top == nullptr) {
+                return std::nullopt;
+            }
+            Node* next = top->next.load(std::memory_order_relaxed);
+            if (head.compare_exchange_weak(old_head, pack(next, old_head),
+                                           std::memory_order_acquire,
+                                           std::memory_order_acquire)) {
+                return take(top);
+            }
+            if (Node* given = elimination.try_take()) {
+                return take(given);
+            }
+            old_head = head.load(std::memory_order_acquire);
+        }
+    }
+
+    // Pushes a whole range with a single successful compare-exchange.
+    // The last element of the range ends up on top.
+    template <std::input_iterator It>
+    requires std::convertible_to<std::iter_reference_t<It>, T>
+    void push_chain(It first, It last) {
+        Node* top = nullptr;
+        Node* bottom = nullptr;
+        for (; first != last; ++first) {
+            Node* node = make_node();
+            node->next.store(top, std::memory_order_relaxed);
+            top = node;
+            if (bottom == nullptr) {
+                bottom = node;
+            }
+            try {
+                node->value.emplace(*first);
+            } catch (...) {
+                // Nothing was published; the whole chain goes back unused
+                for (Node* n = top; n; n = n->next.load(std::memory_order_relaxed)) {
+                    n->value.reset();
+                }
+                push_nodes(free_nodes, top, bottom);
+                throw;
+            }
+        }
+        if (top != nullptr) {
+            push_nodes(head, top, bottom);
+        }
+    }
+
+    // Detaches every element at once; values come back in pop order
+    std::vector<T> pop_all() {
+        std::uint64_t old_head = head.load(std::memory_order_acquire);
+        while (!head.compare_exchange_weak(old_head, pack(nullptr, old_head),
+                                           std::memory_order_acquire,
+                                           std::memory_order_acquire)) {
+        }
+
+        std::vector<T> values;
+        Node* first = pointer_of(old_head);
+        Node* last = nullptr;
+        for (Node* node = first; node; node = node->next.load(std::memory_order_relaxed)) {
+            values.push_back(std::move(*node->value));
+            node->value.reset();
+            last = node;
+        }
+        if (first != nullptr) {
+            push_nodes(free_nodes, first, last);
+        }
+        return values;
+    }
+
+    // A snapshot; may be stale as soon as it returns
+    [[nodiscard]] bool empty() const noexcept {
+        return pointer_of(head.load(std::memory_order_acquire)) == nullptr;
+    }
+
+private:
+    T take(Node* node) {
+        T value = std::move(*node->value);
+        recycle(node);
+        return value;
+    }
+};
+
+#endif // CONCURRENT_STACK_HPP
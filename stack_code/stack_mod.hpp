@@ -2,8 +2,16 @@
 #define STACK_HPP
 
 #include <vector>
+#include <array>
+#include <memory>
+#include <string>
+#include <optional>
+#include <concepts>
 #include <stdexcept>
-#include <format>
+#include <algorithm>
+#include <cstddef>
+#include "../memory_manage/container_stats.hpp"
+#include "../memory_manage/serialization.hpp"
 
 class StackException : public std::runtime_error {
 public:
@@ -11,18 +19,19 @@ public:
         : std::runtime_error(message) {}
 };
 
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class Stack {
 public:
     // Constructor with C++20 constraints
-    explicit Stack(size_t capacity = default_size) 
-        requires (std::movable<T>) {
+    explicit Stack(size_t capacity = default_size, const Allocator& alloc = Allocator())
+        requires (std::movable<T>) : elements(alloc) {
         if (capacity > max_size || capacity < 1) {
             throw StackException(
-                std::format("Invalid stack size: {}. Must be between 1 and {}", 
-                           capacity, max_size));
+                "Invalid stack size: " + std::to_string(capacity) +
+                ". Must be between 1 and " + std::to_string(max_size));
         }
         elements.reserve(capacity);
+        instrumentation.grow(0, elements.capacity() * sizeof(T), 0, sizeof(T));
     }
 
     // Stack operations with noexcept specifications
@@ -88,10 +97,340 @@ public:
         return elements.back();
     }
 
+    // The buffer reserved up front; zero unless built with CONTAINER_STATS
+    [[nodiscard]] const container_stats::Counters& stats() const noexcept {
+        return instrumentation.counters();
+    }
+
+    // Binary form: frame, capacity, then the elements bottom to top (see
+    // serialization.hpp). deserialize replaces the contents and capacity and
+    // leaves them untouched if the input is bad
+    void serialize(serialization::Encoder& out) const {
+        serialization::write_header(out, serialization::ContainerKind::stack, serialization::layout_tag<T>,
+                                    elements.size());
+        out.write(static_cast<std::uint64_t>(elements.capacity()));
+        out.write_array(elements.data(), elements.size());
+    }
+
+    void deserialize(serialization::Decoder& in) {
+        std::uint64_t count =
+            serialization::read_header(in, serialization::ContainerKind::stack, serialization::layout_tag<T>);
+        auto capacity = in.read<std::uint64_t>();
+        if (capacity < 1 || capacity > max_size || count > capacity) {
+            throw serialization::Error("serialization: stack of " + std::to_string(count) + " elements, capacity " +
+                                       std::to_string(capacity));
+        }
+        std::vector<T, Allocator> incoming(elements.get_allocator());
+        incoming.reserve(static_cast<size_t>(capacity));
+        in.read_append(incoming, count);
+        instrumentation.free(elements.capacity() * sizeof(T));
+        instrumentation.allocation(incoming.capacity() * sizeof(T));
+        elements.swap(incoming);
+    }
+
 private:
     static constexpr size_t default_size = 10;
     static constexpr size_t max_size = 1000;
-    std::vector<T> elements;
+    std::vector<T, Allocator> elements;
+    [[no_unique_address]] container_stats::InstanceStats<container_stats::Kind::stack> instrumentation;
+};
+
+// Fixed-capacity stack with inline std::array storage.
+// Never allocates, so it can be used in constexpr contexts and on hot paths
+// where the maximum depth is known up front.
+template <typename T, size_t N>
+requires (N > 0 && std::default_initializable<T> && std::movable<T>)
+class FixedStack {
+public:
+    constexpr FixedStack() = default;
+
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return count == 0;
+    }
+
+    [[nodiscard]] constexpr bool full() const noexcept {
+        return count == N;
+    }
+
+    [[nodiscard]] constexpr size_t size() const noexcept {
+        return count;
+    }
+
+    [[nodiscard]] static constexpr size_t capacity() noexcept {
+        return N;
+    }
+
+    template <typename U>
+    requires std::convertible_to<U, T>
+    constexpr T& push(U&& value) {
+        if (full()) {
+            throw StackException("Stack is full");
+        }
+        elements[count] = std::forward<U>(value);
+        return elements[count++];
+    }
+
+    constexpr std::optional<T> try_pop() noexcept {
+        if (empty()) {
+            return std::nullopt;
+        }
+        return std::move(elements[--count]);
+    }
+
+    constexpr T pop() {
+        if (empty()) {
+            throw StackException("Stack is empty");
+        }
+        return std::move(elements[--count]);
+    }
+
+    [[nodiscard]] constexpr const T& peek() const {
+        if (empty()) {
+            throw StackException("Stack is empty");
+        }
+        return elements[count - 1];
+    }
+
+    [[nodiscard]] constexpr T& peek() {
+        if (empty()) {
+            throw StackException("Stack is empty");
+        }
+        return elements[count - 1];
+    }
+
+    // Reset slots to T{} so that resources held by popped values are released
+    constexpr void clear() noexcept(std::is_nothrow_default_constructible_v<T>) {
+        for (size_t i = 0; i < count; ++i) {
+            elements[i] = T{};
+        }
+        count = 0;
+    }
+
+private:
+    std::array<T, N> elements{};
+    size_t count = 0;
+};
+
+// Growable stack that keeps the first N elements inline and spills to the
+// heap with geometric growth once it outgrows them. There is no size ceiling.
+template <typename T, size_t N = 16>
+requires (N > 0 && std::movable<T>)
+class SmallStack {
+public:
+    SmallStack() noexcept = default;
+
+    explicit SmallStack(size_t initial_capacity) {
+        reserve(initial_capacity);
+    }
+
+    SmallStack(const SmallStack& other) requires std::copy_constructible<T> {
+        reserve(other.count);
+        try {
+            std::uninitialized_copy_n(other.first, other.count, first);
+        } catch (...) {
+            release();
+            throw;
+        }
+        count = other.count;
+    }
+
+    SmallStack(SmallStack&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        steal(other);
+    }
+
+    SmallStack& operator=(const SmallStack& other) requires std::copy_constructible<T> {
+        if (this != &other) {
+            SmallStack copy(other);
+            clear();
+            release();
+            steal(copy);
+        }
+        return *this;
+    }
+
+    SmallStack& operator=(SmallStack&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            release();
+            steal(other);
+        }
+        return *this;
+    }
+
+    ~SmallStack() {
+        clear();
+        release();
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return count == 0;
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return count;
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept {
+        return cap;
+    }
+
+    // True while the elements still live in the inline buffer
+    [[nodiscard]] bool is_inline() const noexcept {
+        return first == inline_data();
+    }
+
+    template <typename U>
+    requires std::convertible_to<U, T>
+    T& push(U&& value) {
+        return emplace(std::forward<U>(value));
+    }
+
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        if (count == cap) {
+            return emplace_with_growth(std::forward<Args>(args)...);
+        }
+        T* slot = std::construct_at(first + count, std::forward<Args>(args)...);
+        ++count;
+        return *slot;
+    }
+
+    std::optional<T> try_pop() noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (empty()) {
+            return std::nullopt;
+        }
+        std::optional<T> value(std::move(first[count - 1]));
+        std::destroy_at(first + --count);
+        return value;
+    }
+
+    T pop() {
+        if (empty()) {
+            throw StackException("Stack is empty");
+        }
+        T value = std::move(first[count - 1]);
+        std::destroy_at(first + --count);
+        return value;
+    }
+
+    [[nodiscard]] const T& peek() const {
+        if (empty()) {
+            throw StackException("Stack is empty");
+        }
+        return first[count - 1];
+    }
+
+    [[nodiscard]] T& peek() {
+        if (empty()) {
+            throw StackException("Stack is empty");
+        }
+        return first[count - 1];
+    }
+
+    // Heap buffers and the elements moved into them; zero unless built with
+    // CONTAINER_STATS
+    [[nodiscard]] const container_stats::Counters& stats() const noexcept {
+        return instrumentation.counters();
+    }
+
+    void reserve(size_t new_capacity) {
+        if (new_capacity > cap) {
+            T* fresh = std::allocator<T>().allocate(new_capacity);
+            try {
+                relocate_to(fresh, new_capacity);
+            } catch (...) {
+                std::allocator<T>().deallocate(fresh, new_capacity);
+                throw;
+            }
+        }
+    }
+
+    // Destroys the elements but keeps the current buffer
+    void clear() noexcept {
+        std::destroy_n(first, count);
+        count = 0;
+    }
+
+private:
+    T* inline_data() noexcept {
+        return reinterpret_cast<T*>(inline_storage);
+    }
+
+    const T* inline_data() const noexcept {
+        return reinterpret_cast<const T*>(inline_storage);
+    }
+
+    // Grow geometrically; the new element is built before the old ones move
+    // so that arguments referring into the stack stay valid.
+    template <typename... Args>
+    T& emplace_with_growth(Args&&... args) {
+        size_t new_capacity = cap * 2;
+        T* fresh = std::allocator<T>().allocate(new_capacity);
+        T* slot;
+        try {
+            slot = std::construct_at(fresh + count, std::forward<Args>(args)...);
+        } catch (...) {
+            std::allocator<T>().deallocate(fresh, new_capacity);
+            throw;
+        }
+        try {
+            relocate_to(fresh, new_capacity);
+        } catch (...) {
+            std::destroy_at(slot);
+            std::allocator<T>().deallocate(fresh, new_capacity);
+            throw;
+        }
+        ++count;
+        return *slot;
+    }
+
+    void relocate_to(T* fresh, size_t new_capacity) {
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::copy_constructible<T>) {
+            std::uninitialized_move_n(first, count, fresh);
+        } else {
+            std::uninitialized_copy_n(first, count, fresh);
+        }
+        std::destroy_n(first, count);
+        // grow() accounts for the old buffer, so free it without release()
+        instrumentation.grow(is_inline() ? 0 : cap * sizeof(T), new_capacity * sizeof(T), count, sizeof(T));
+        if (!is_inline()) {
+            std::allocator<T>().deallocate(first, cap);
+        }
+        first = fresh;
+        cap = new_capacity;
+    }
+
+    void release() noexcept {
+        if (!is_inline()) {
+            instrumentation.free(cap * sizeof(T));
+            std::allocator<T>().deallocate(first, cap);
+            first = inline_data();
+            cap = N;
+        }
+    }
+
+    // Takes over other's elements; expects *this to be empty and inline
+    void steal(SmallStack& other) {
+        if (other.is_inline()) {
+            std::uninitialized_move_n(other.first, other.count, first);
+            count = other.count;
+            other.clear();
+        } else {
+            instrumentation.transfer(other.instrumentation, other.cap * sizeof(T));
+            first = other.first;
+            cap = other.cap;
+            count = other.count;
+            other.first = other.inline_data();
+            other.cap = N;
+            other.count = 0;
+        }
+    }
+
+    alignas(T) std::byte inline_storage[N * sizeof(T)];
+    T* first = inline_data();
+    size_t count = 0;
+    size_t cap = N;
+    [[no_unique_address]] container_stats::InstanceStats<container_stats::Kind::stack> instrumentation;
 };
 
 #endif // STACK_HPP
\ No newline at end of file
@@ -56,5 +56,31 @@ int main() {
         std::cerr << "Stack error: " << e.what() << '\n';
     }
 
+    // Fixed-capacity stack evaluated entirely at compile time
+    constexpr int fixedSum = [] {
+        FixedStack<int, 5> fs;
+        for (int i = 1; i <= 5; ++i) {
+            fs.push(i);
+        }
+        int sum = 0;
+        while (!fs.empty()) {
+            sum += fs.pop();
+        }
+        return sum;
+    }();
+    static_assert(fixedSum == 15);
+    std::cout << "\nFixedStack sum computed at compile time: " << fixedSum << '\n';
+
+    // Growable stack: starts in its inline buffer, then moves to the heap
+    SmallStack<std::string, 4> small;
+    for (int i = 0; i < 10; ++i) {
+        small.push("item " + std::to_string(i));
+        std::cout << "Pushed item " << i << " (capacity " << small.capacity()
+                  << (small.is_inline() ? ", inline)" : ", heap)") << '\n';
+    }
+    while (auto value = small.try_pop()) {
+        std::cout << "Popped: " << *value << '\n';
+    }
+
     return 0;
 }
\ No newline at end of file